@@ -4,163 +4,2189 @@
 #include <fstream>
 #include <cstdlib>
 #include <ctime>
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <array>
+#include <random>
+#include <unordered_map>
+#include <memory_resource>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
-class Tile {
+// cell state bits, every cell is packed into a single byte
+const unsigned char CELL_COUNT = 0x0F;   // surrounding mine count (0-8)
+const unsigned char CELL_MINE = 0x10;
+const unsigned char CELL_HIDDEN = 0x20;
+const unsigned char CELL_FLAGGED = 0x40;
+const unsigned char CELL_BORDER = 0x80;  // sentinel ring around the board
+
+// a tile the player can still open: hidden and not flagged
+inline bool isOpenable(unsigned char cell) {
+    return (cell & (CELL_HIDDEN | CELL_FLAGGED)) == CELL_HIDDEN;
+}
+
+// an openable tile with no surrounding mines, opening it spreads to its neighbors
+inline bool isOpenableBlank(unsigned char cell) {
+    return (cell & (CELL_HIDDEN | CELL_FLAGGED | CELL_MINE | CELL_COUNT)) == CELL_HIDDEN;
+}
+
+// neighbor counting kernels, run in place over the padded cell layout
+// (stride cols + 2, a ring of border cells with no mine bit around the board):
+// every tile gets the number of mines among its eight neighbors in its count
+// bits, mines keep a count of zero. only mine bits are read, so writing the
+// counts back into the same rows can't disturb the sums still to come
+inline void countNeighborsScalar(unsigned char *cells, int cols, int rows, int startX) {
+    int stride = cols + 2;
+    for (int y = 1; y <= rows; ++y) {
+        const unsigned char *up = cells + (y - 1) * stride;
+        unsigned char *mid = cells + y * stride;
+        const unsigned char *down = cells + (y + 1) * stride;
+        for (int x = startX; x < cols; ++x) {
+            unsigned char sum = ((up[x] & CELL_MINE) + (up[x + 1] & CELL_MINE) + (up[x + 2] & CELL_MINE) +
+                                 (mid[x] & CELL_MINE) + (mid[x + 2] & CELL_MINE) +
+                                 (down[x] & CELL_MINE) + (down[x + 1] & CELL_MINE) + (down[x + 2] & CELL_MINE)) >> 4;
+            unsigned char cell = mid[x + 1];
+            mid[x + 1] = (cell & ~CELL_COUNT) | ((cell & CELL_MINE) ? 0 : sum);
+        }
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MINESWEEPER_X86_SIMD 1
+// mingw gcc can't keep the stack 32-byte aligned (gcc PR 54412) and spills
+// __m256i locals with aligned moves, so windows gcc builds stop at SSE2
+#if !defined(_WIN32)
+#define MINESWEEPER_X86_AVX2 1
+#endif
+
+// the widest kernel the cpu supports: 2 for AVX2, 1 for SSE2, 0 for scalar
+inline int simdLevel() {
+#ifdef MINESWEEPER_X86_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return 2;
+    }
+#endif
+    return __builtin_cpu_supports("sse2") ? 1 : 0;
+}
+
+__attribute__((target("sse2")))
+void countNeighborsSSE2(unsigned char *cells, int cols, int rows) {
+    int stride = cols + 2;
+    int vectorCols = cols & ~15;
+    const __m128i mineBit = _mm_set1_epi8(CELL_MINE);
+    const __m128i countBits = _mm_set1_epi8(CELL_COUNT);
+    for (int y = 1; y <= rows; ++y) {
+        const unsigned char *up = cells + (y - 1) * stride;
+        unsigned char *mid = cells + y * stride;
+        const unsigned char *down = cells + (y + 1) * stride;
+        for (int x = 0; x < vectorCols; x += 16) {
+            // each mine contributes 0x10, eight of them still fit in a byte
+            __m128i sum = _mm_and_si128(_mm_loadu_si128((const __m128i *)(up + x)), mineBit);
+            sum = _mm_add_epi8(sum, _mm_and_si128(_mm_loadu_si128((const __m128i *)(up + x + 1)), mineBit));
+            sum = _mm_add_epi8(sum, _mm_and_si128(_mm_loadu_si128((const __m128i *)(up + x + 2)), mineBit));
+            sum = _mm_add_epi8(sum, _mm_and_si128(_mm_loadu_si128((const __m128i *)(mid + x)), mineBit));
+            sum = _mm_add_epi8(sum, _mm_and_si128(_mm_loadu_si128((const __m128i *)(mid + x + 2)), mineBit));
+            sum = _mm_add_epi8(sum, _mm_and_si128(_mm_loadu_si128((const __m128i *)(down + x)), mineBit));
+            sum = _mm_add_epi8(sum, _mm_and_si128(_mm_loadu_si128((const __m128i *)(down + x + 1)), mineBit));
+            sum = _mm_add_epi8(sum, _mm_and_si128(_mm_loadu_si128((const __m128i *)(down + x + 2)), mineBit));
+            __m128i count = _mm_and_si128(_mm_srli_epi16(sum, 4), countBits);
+
+            __m128i cell = _mm_loadu_si128((const __m128i *)(mid + x + 1));
+            __m128i isMine = _mm_cmpeq_epi8(_mm_and_si128(cell, mineBit), mineBit);
+            count = _mm_andnot_si128(isMine, count);
+            cell = _mm_or_si128(_mm_andnot_si128(countBits, cell), count);
+            _mm_storeu_si128((__m128i *)(mid + x + 1), cell);
+        }
+    }
+    countNeighborsScalar(cells, cols, rows, vectorCols);
+}
+
+#ifdef MINESWEEPER_X86_AVX2
+__attribute__((target("avx2")))
+void countNeighborsAVX2(unsigned char *cells, int cols, int rows) {
+    int stride = cols + 2;
+    int vectorCols = cols & ~31;
+    const __m256i mineBit = _mm256_set1_epi8(CELL_MINE);
+    const __m256i countBits = _mm256_set1_epi8(CELL_COUNT);
+    for (int y = 1; y <= rows; ++y) {
+        const unsigned char *up = cells + (y - 1) * stride;
+        unsigned char *mid = cells + y * stride;
+        const unsigned char *down = cells + (y + 1) * stride;
+        for (int x = 0; x < vectorCols; x += 32) {
+            __m256i sum = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(up + x)), mineBit);
+            sum = _mm256_add_epi8(sum, _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(up + x + 1)), mineBit));
+            sum = _mm256_add_epi8(sum, _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(up + x + 2)), mineBit));
+            sum = _mm256_add_epi8(sum, _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(mid + x)), mineBit));
+            sum = _mm256_add_epi8(sum, _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(mid + x + 2)), mineBit));
+            sum = _mm256_add_epi8(sum, _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(down + x)), mineBit));
+            sum = _mm256_add_epi8(sum, _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(down + x + 1)), mineBit));
+            sum = _mm256_add_epi8(sum, _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(down + x + 2)), mineBit));
+            __m256i count = _mm256_and_si256(_mm256_srli_epi16(sum, 4), countBits);
+
+            __m256i cell = _mm256_loadu_si256((const __m256i *)(mid + x + 1));
+            __m256i isMine = _mm256_cmpeq_epi8(_mm256_and_si256(cell, mineBit), mineBit);
+            count = _mm256_andnot_si256(isMine, count);
+            cell = _mm256_or_si256(_mm256_andnot_si256(countBits, cell), count);
+            _mm256_storeu_si256((__m256i *)(mid + x + 1), cell);
+        }
+    }
+    countNeighborsScalar(cells, cols, rows, vectorCols);
+}
+#endif
+#endif
+
+// picks the widest kernel the cpu supports, checked once at runtime
+void countNeighbors(unsigned char *cells, int cols, int rows) {
+#ifdef MINESWEEPER_X86_SIMD
+    static const int level = simdLevel();
+#ifdef MINESWEEPER_X86_AVX2
+    // boards narrower than one AVX2 step get more out of SSE2
+    if (level == 2 && cols >= 32) {
+        countNeighborsAVX2(cells, cols, rows);
+        return;
+    }
+#endif
+    if (level >= 1) {
+        countNeighborsSSE2(cells, cols, rows);
+        return;
+    }
+#endif
+    countNeighborsScalar(cells, cols, rows, 0);
+}
+
+// one axis of a separable box sum over bytes: to[i] is the sum of from at
+// i - step, i and i + step, for i in [begin, end)
+inline void sumAlongAxisScalar(const unsigned char *from, unsigned char *to, size_t begin, size_t end, size_t step) {
+    for (size_t i = begin; i < end; ++i) {
+        to[i] = from[i - step] + from[i] + from[i + step];
+    }
+}
+
+#ifdef MINESWEEPER_X86_SIMD
+__attribute__((target("sse2")))
+void sumAlongAxisSSE2(const unsigned char *from, unsigned char *to, size_t begin, size_t end, size_t step) {
+    size_t i = begin;
+    for (; i + 16 <= end; i += 16) {
+        __m128i sum = _mm_add_epi8(_mm_loadu_si128((const __m128i *)(from + i - step)),
+                                   _mm_loadu_si128((const __m128i *)(from + i)));
+        sum = _mm_add_epi8(sum, _mm_loadu_si128((const __m128i *)(from + i + step)));
+        _mm_storeu_si128((__m128i *)(to + i), sum);
+    }
+    sumAlongAxisScalar(from, to, i, end, step);
+}
+
+#ifdef MINESWEEPER_X86_AVX2
+__attribute__((target("avx2")))
+void sumAlongAxisAVX2(const unsigned char *from, unsigned char *to, size_t begin, size_t end, size_t step) {
+    size_t i = begin;
+    for (; i + 32 <= end; i += 32) {
+        __m256i sum = _mm256_add_epi8(_mm256_loadu_si256((const __m256i *)(from + i - step)),
+                                      _mm256_loadu_si256((const __m256i *)(from + i)));
+        sum = _mm256_add_epi8(sum, _mm256_loadu_si256((const __m256i *)(from + i + step)));
+        _mm256_storeu_si256((__m256i *)(to + i), sum);
+    }
+    sumAlongAxisScalar(from, to, i, end, step);
+}
+#endif
+#endif
+
+void sumAlongAxis(const unsigned char *from, unsigned char *to, size_t begin, size_t end, size_t step) {
+#ifdef MINESWEEPER_X86_SIMD
+    static const int level = simdLevel();
+#ifdef MINESWEEPER_X86_AVX2
+    if (level == 2) {
+        sumAlongAxisAVX2(from, to, begin, end, step);
+        return;
+    }
+#endif
+    if (level >= 1) {
+        sumAlongAxisSSE2(from, to, begin, end, step);
+        return;
+    }
+#endif
+    sumAlongAxisScalar(from, to, begin, end, step);
+}
+
+// small seeded generator (PCG32), so a board can be rebuilt from its seed
+class Pcg32 {
+public:
+    Pcg32(uint64_t seed = 0) {
+        seedWith(seed);
+    }
+
+    void seedWith(uint64_t seed) {
+        state = 0;
+        increment = (uint64_t(0xda3e39cb94b95bdbULL) << 1) | 1;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t shifted = uint32_t(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = uint32_t(old >> 59);
+        return (shifted >> rotation) | (shifted << ((32 - rotation) & 31));
+    }
+
+    // unbiased integer in [0, bound) using Lemire's multiply-and-reject
+    uint32_t below(uint32_t bound) {
+        uint64_t product = uint64_t(next()) * bound;
+        uint32_t low = uint32_t(product);
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = uint64_t(next()) * bound;
+                low = uint32_t(product);
+            }
+        }
+        return uint32_t(product >> 32);
+    }
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
+
+// a fresh seed for a new board
+uint64_t randomSeed() {
+    random_device device;
+    return (uint64_t(device()) << 32) ^ device();
+}
+
+// everything needed to regenerate a board, written as "COLSxROWSxMINES-SEED",
+// then "h" or "t" for hex and torus boards (nothing for square ones), then
+// "@X,Y" when the mines were placed around a first click at X, Y
+struct BoardId {
+    int cols;
+    int rows;
+    int mines;
+    uint64_t seed;
+    int safeX;
+    int safeY;
+    // the topology's idSuffix, 0 for square boards
+    char topology;
+
+    string toString() const {
+        char buffer[96];
+        int length = snprintf(buffer, sizeof(buffer), "%dx%dx%d-%016llx", cols, rows, mines, (unsigned long long)seed);
+        if (topology) {
+            buffer[length++] = topology;
+            buffer[length] = 0;
+        }
+        if (safeX >= 0) {
+            snprintf(buffer + length, sizeof(buffer) - length, "@%d,%d", safeX, safeY);
+        }
+        return buffer;
+    }
+
+    static bool parse(const string &text, BoardId &id) {
+        unsigned long long seed;
+        int length = 0;
+        if (sscanf(text.c_str(), "%dx%dx%d-%llx%n", &id.cols, &id.rows, &id.mines, &seed, &length) != 4) {
+            return false;
+        }
+        const char *rest = text.c_str() + length;
+        id.seed = seed;
+        id.topology = 0;
+        if (*rest == 'h' || *rest == 't') {
+            id.topology = *rest++;
+        }
+        id.safeX = -1;
+        id.safeY = -1;
+        if (*rest == '@') {
+            length = 0;
+            if (sscanf(rest, "@%d,%d%n", &id.safeX, &id.safeY, &length) != 2 || id.safeX < 0 || id.safeX >= id.cols ||
+                id.safeY < 0 || id.safeY >= id.rows) {
+                return false;
+            }
+            rest += length;
+        }
+        // config files edited on windows end their lines with \r
+        while (*rest == ' ' || *rest == '\t' || *rest == '\r' || *rest == '\n') {
+            rest++;
+        }
+        return *rest == 0 && id.cols > 0 && id.rows > 0 && id.mines >= 0;
+    }
+};
+
+// forwards to another resource and counts what passes through, so a game
+// can report how often it still reaches the global heap
+class CountingResource : public pmr::memory_resource {
+public:
+    size_t allocations;
+    size_t deallocations;
+    size_t bytesInUse;
+
+    explicit CountingResource(pmr::memory_resource *target = pmr::new_delete_resource())
+        : allocations(0), deallocations(0), bytesInUse(0), upstream(target) {}
+
+private:
+    pmr::memory_resource *upstream;
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        bytesInUse += bytes;
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *pointer, size_t bytes, size_t alignment) override {
+        deallocations++;
+        bytesInUse -= bytes;
+        upstream->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// allocations of one game window. the board and leaderboard live in session
+// for as long as the window is open; reveal scratch and other per-game
+// containers go to game, which drops back to its first buffer with a single
+// release() at every restart. both draw from heap, which keeps the counts
+class GameArena {
+public:
+    CountingResource heap;
+    pmr::monotonic_buffer_resource session;
+    pmr::monotonic_buffer_resource game;
+
+    GameArena(size_t sessionBytes, size_t gameBytes)
+        : session(sessionBytes + gameBytes, &heap), game(session.allocate(gameBytes), gameBytes, &heap) {}
+
+    // frees everything the last game allocated past its first buffer
+    void restart() {
+        game.release();
+    }
+
+    void report(const char *when) const {
+        cout << "allocations " << when << ": " << heap.allocations << " from the heap, "
+             << heap.bytesInUse << " bytes held" << endl;
+    }
+};
+
+// boards larger than this skip the opening index (about nine bytes per cell)
+// and reveal with the fill alone
+const int OPENING_INDEX_MAX_CELLS = 1 << 24;
+
+// when a board puts its mines down
+enum MinePlacement {
+    PLACE_MINES_NOW,
+    // keeps the first tile revealed and its neighbors clear
+    PLACE_MINES_ON_FIRST_REVEAL
+};
+
+// board sizes that are only known at runtime
+const int DYNAMIC_SIZE = 0;
+
+// cell storage: a fixed-size array when the board size is a compile-time
+// preset, a vector for boards sized at runtime
+template <int Cols, int Rows>
+struct CellStorage {
+    typedef array<unsigned char, size_t(Cols + 2) * (Rows + 2)> type;
+    static type create(pmr::memory_resource *) {
+        return type();
+    }
+    static void resize(type &, size_t) {}
+};
+
+template <>
+struct CellStorage<DYNAMIC_SIZE, DYNAMIC_SIZE> {
+    typedef pmr::vector<unsigned char> type;
+    static type create(pmr::memory_resource *resource) {
+        return type(resource);
+    }
+    static void resize(type &cells, size_t count) {
+        cells.resize(count);
+    }
+};
+
+// cell orders a board can keep its padded grid in; positions here are padded
+// coordinates, with the border ring at -1 shifted to 0. row-major is the
+// default, and the one the SIMD kernels and the scanline fill are written for
+struct RowMajorLayout {
+    static const bool rowMajor = true;
+
+    // cells per row
+    static int layoutStride(int paddedCols) {
+        return paddedCols;
+    }
+    static size_t cellCount(int paddedCols, int paddedRows) {
+        return size_t(paddedCols) * paddedRows;
+    }
+    static int index(int px, int py, int stride) {
+        return py * stride + px;
+    }
+    static sf::Vector2i position(int index, int stride) {
+        return sf::Vector2i(index % stride, index / stride);
+    }
+};
+
+// 8x8 tiles of 64 cells, one cache line each, stored tile row by tile row;
+// inside a tile the cells follow the Z (Morton) curve. most cells then find
+// all eight neighbors in their own line instead of in three distant rows
+struct TiledLayout {
+    static const bool rowMajor = false;
+
+    // tiles per row
+    static int layoutStride(int paddedCols) {
+        return (paddedCols + 7) / 8;
+    }
+    static size_t cellCount(int paddedCols, int paddedRows) {
+        return size_t(layoutStride(paddedCols)) * ((paddedRows + 7) / 8) * 64;
+    }
+    // spreads three bits to every other bit, and back
+    static int spreadBits(int value) {
+        return (value & 1) | ((value & 2) << 1) | ((value & 4) << 2);
+    }
+    static int gatherBits(int value) {
+        return (value & 1) | ((value >> 1) & 2) | ((value >> 2) & 4);
+    }
+    static int index(int px, int py, int stride) {
+        return (((py >> 3) * stride + (px >> 3)) << 6) | spreadBits(px & 7) | (spreadBits(py & 7) << 1);
+    }
+    static sf::Vector2i position(int index, int stride) {
+        int tile = index >> 6;
+        return sf::Vector2i((tile % stride) * 8 + gatherBits(index), (tile / stride) * 8 + gatherBits(index >> 1));
+    }
+    // the cell dx, dy (-1 to 1) away, without decoding the whole position:
+    // stepping off a tile edge moves to the next tile and wraps inside it
+    static int step(int index, int dx, int dy, int stride) {
+        int x = gatherBits(index) + dx;
+        int y = gatherBits(index >> 1) + dy;
+        int tile = (index >> 6) + (x >> 3) + (y >> 3) * stride;
+        return (tile << 6) | spreadBits(x & 7) | (spreadBits(y & 7) << 1);
+    }
+};
+
+// offset of neighbor k (0-7, row by row around the center) in a padded grid
+constexpr int neighborOffset(int k, int stride) {
+    return ((k < 4 ? k : k + 1) / 3 - 1) * stride + (k < 4 ? k : k + 1) % 3 - 1;
+}
+
+// how tiles touch. every topology lists its neighbors as (dx, dy) steps,
+// one table for tiles on even rows and one for odd rows, in row-major order
+// so the first half are the neighbors above and to the left
+struct SquareTopology {
+    static const int neighborCount = 8;
+    // odd rows sit half a tile to the right
+    static const bool hexRows = false;
+    // opposite edges are joined, there is no border
+    static const bool wraps = false;
+    // marks the topology in board ids
+    static constexpr char idSuffix = 0;
+    static constexpr int steps[2][8][2] = {
+        {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}},
+        {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}}
+    };
+};
+
+// hexagons in offset rows: a tile touches two tiles in each row next to its
+// own, which two depends on which way its row is shifted
+struct HexTopology {
+    static const int neighborCount = 6;
+    static const bool hexRows = true;
+    static const bool wraps = false;
+    static constexpr char idSuffix = 'h';
+    static constexpr int steps[2][6][2] = {
+        {{-1, -1}, {0, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}},
+        {{0, -1}, {1, -1}, {-1, 0}, {1, 0}, {0, 1}, {1, 1}}
+    };
+};
+
+// the square grid on a torus: stepping off one edge comes back on the other
+struct TorusTopology {
+    static const int neighborCount = 8;
+    static const bool hexRows = false;
+    static const bool wraps = true;
+    static constexpr char idSuffix = 't';
+    static constexpr int steps[2][8][2] = {
+        {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}},
+        {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}}
+    };
+};
+
+// value moved back into [0, size) after a step of at most size, with masks
+// instead of branches or a division
+inline int wrapInto(int value, int size) {
+    return value + (size & -int(value < 0)) - (size & -int(value >= size));
+}
+
+// lightweight handle onto one cell byte owned by the board
+template <class BoardT>
+class BasicTile {
+public:
+    BasicTile(BoardT &owner, int cellIndex) : board(owner), index(cellIndex) {}
+
+    bool isHidden() const {
+        return (board.cells[index] & CELL_HIDDEN) != 0;
+    }
+    void setHidden(bool value) {
+        unsigned char state = board.cells[index];
+        board.setCell(index, value ? state | CELL_HIDDEN : state & ~CELL_HIDDEN);
+    }
+    bool isFlagged() const {
+        return (board.cells[index] & CELL_FLAGGED) != 0;
+    }
+    void setFlagged(bool value) {
+        unsigned char state = board.cells[index];
+        board.setCell(index, value ? state | CELL_FLAGGED : state & ~CELL_FLAGGED);
+    }
+    bool isMine() const {
+        return (board.cells[index] & CELL_MINE) != 0;
+    }
+    unsigned int getSurroundingMines() const {
+        return board.cells[index] & CELL_COUNT;
+    }
+
+private:
+    BoardT &board;
+    int index;
+};
+
+// Cols and Rows fix the size at compile time for the common presets, so the
+// hot loops see constant strides and offsets; the default is sized at runtime.
+// Layout picks the cell order, huge boards can trade the row-major fast paths
+// for TiledLayout's locality. Topology picks which tiles touch; every choice
+// is a compile-time constant, so the loops carry no checks for the others
+template <int Cols = DYNAMIC_SIZE, int Rows = DYNAMIC_SIZE, class Layout = RowMajorLayout,
+          class Topology = SquareTopology>
+class BasicBoard {
+public:
+    typedef BasicTile<BasicBoard> Tile;
+    typedef Layout CellLayout;
+    typedef Topology CellTopology;
+    static const bool fixedSize = Cols != DYNAMIC_SIZE && Rows != DYNAMIC_SIZE;
+    static const int neighborCount = Topology::neighborCount;
+    static_assert(Layout::rowMajor || !fixedSize, "fixed-size boards are row-major");
+    static_assert(Layout::rowMajor || (!Topology::hexRows && !Topology::wraps), "tiled boards are square");
+
+    int rows;
+    int cols;
+    int mines;
+    // one packed state byte per cell in Layout order, padded with a ring of
+    // border cells so neighbor visits never need bounds checks
+    typename CellStorage<Cols, Rows>::type cells;
+    // Layout's stride: cells per row, or tiles per row for TiledLayout
+    int stride;
+    // index offsets of the neighbors of any tile, by padded row parity
+    int neighborOffsets[2][8];
+    // live counters kept up to date by every cell write, so the
+    // win check never has to scan the board
+    int hiddenSafe;
+    int revealedCount;
+    int correctFlags;
+    int placedMines;
+    // cell index of every mine, so mine-only passes skip the safe tiles;
+    // removing a mine only marks it stale, mineList() rebuilds it on demand
+    pmr::vector<int> mineCells;
+    bool mineIndexDirty;
+    // mines are drawn from rng, which always starts from seed
+    uint64_t seed;
+    Pcg32 rng;
+    // deferred boards have no mines until the first reveal, then remember
+    // the tile the mines were kept away from (-1 until then)
+    MinePlacement placement;
+    bool minesPending;
+    int safeX;
+    int safeY;
+    // openings: each connected region of blank tiles together with the
+    // numbered tiles around it, labelled once the counts are known so a click
+    // on a blank opens its region straight from a member list. openingOf
+    // labels the blank tiles (-1 elsewhere); opening k's members are
+    // openingMembers[openingStart[k]] up to openingMembers[openingStart[k + 1]]
+    bool openingsValid;
+    pmr::vector<int> openingOf;
+    pmr::vector<int> openingStart;
+    pmr::vector<int> openingMembers;
+    // sticky: a blank member was flagged or changed on its own, so the
+    // region may be split and reveals there go back to the fill
+    pmr::vector<unsigned char> openingTouched;
+
+    // constructor, storage comes from resource (a game's arena, usually)
+    BasicBoard(int numRows, int numCols, int numMines, uint64_t boardSeed = randomSeed(),
+               pmr::memory_resource *resource = pmr::get_default_resource(),
+               MinePlacement minePlacement = PLACE_MINES_NOW)
+        : rows(fixedSize ? Rows : numRows), cols(fixedSize ? Cols : numCols), mines(numMines),
+          cells(CellStorage<Cols, Rows>::create(resource)), mineCells(resource), mineIndexDirty(false),
+          seed(boardSeed), rng(boardSeed),
+          placement(minePlacement), minesPending(false), safeX(-1), safeY(-1), openingsValid(false),
+          openingOf(resource), openingStart(resource), openingMembers(resource), openingTouched(resource) {
+        layoutCells();
+        placeMines();
+    }
+
+    // rebuilds exactly the board the id was taken from, counts included
+    BasicBoard(const BoardId &id, pmr::memory_resource *resource = pmr::get_default_resource())
+        : BasicBoard(id.rows, id.cols, id.mines, id.seed, resource,
+                     id.safeX >= 0 ? PLACE_MINES_ON_FIRST_REVEAL : PLACE_MINES_NOW) {
+        if (id.safeX >= 0) {
+            placeMinesAround(id.safeX, id.safeY);
+        }
+        else {
+            assignSurroundingMines(*this);
+        }
+    }
+
+    BoardId getId() const {
+        BoardId id = {cols, rows, mines, seed, safeX, safeY, Topology::idSuffix};
+        return id;
+    }
+
+    // the next addMines call will draw from the new seed
+    void reseed(uint64_t newSeed) {
+        seed = newSeed;
+        rng.seedWith(newSeed);
+    }
+
+    // starts a new game of the same size on the existing storage: every cell
+    // goes back to hidden in bulk, then mines and counts are placed once.
+    // nothing is allocated, so repeated restarts run at constant memory
+    void reset(uint64_t newSeed = randomSeed()) {
+        reseed(newSeed);
+        layoutCells();
+        placeMines();
+        if (!minesPending) {
+            assignSurroundingMines(*this);
+        }
+    }
+
+    // places the mines now, or leaves them for the first reveal
+    void placeMines() {
+        safeX = -1;
+        safeY = -1;
+        minesPending = placement == PLACE_MINES_ON_FIRST_REVEAL;
+        if (!minesPending) {
+            addMines(mines);
+        }
+    }
+
+    // puts pending mines down once the first tile to open is known: tile
+    // (x, y) and its neighbors stay clear, or just the tile when the board is
+    // too dense for that. counts are bumped around each mine as it lands
+    void placeMinesAround(int x, int y) {
+        if (!minesPending) return;
+        minesPending = false;
+        safeX = x;
+        safeY = y;
+
+        int cols = colCount();
+        int rows = rowCount();
+        int left = max(0, x - 1);
+        int right = min(cols - 1, x + 1);
+        int top = max(0, y - 1);
+        int bottom = min(rows - 1, y + 1);
+        if (mines > cols * rows - (right - left + 1) * (bottom - top + 1)) {
+            left = right = x;
+            top = bottom = y;
+        }
+
+        // Floyd's sampling, as in addMines, over the tiles outside the block.
+        // past about 5% mines on a large board one streamed recount beats
+        // bumping eight scattered neighbors per mine
+        int total = cols * rows - (right - left + 1) * (bottom - top + 1);
+        int numMines = min(mines, total);
+        bool bumpCounts = numMines * 20 <= total || total <= 4096;
+        for (int last = total - numMines; last < total; ++last) {
+            int cell = indexOutside(int(rng.below(uint32_t(last) + 1)), left, top, right, bottom);
+            if (cells[cell] & CELL_MINE) {
+                cell = indexOutside(last, left, top, right, bottom);
+            }
+            if (bumpCounts) {
+                addMineAt(cell);
+                continue;
+            }
+            setCell(cell, cells[cell] | CELL_MINE);
+            mineCells.push_back(cell);
+        }
+        if (!bumpCounts) {
+            assignSurroundingMines(*this);
+            return;
+        }
+        indexOpenings();
+    }
+
+    // cell index of the i-th tile, in row-major order, outside a block of tiles
+    int indexOutside(int i, int left, int top, int right, int bottom) const {
+        int cols = colCount();
+        int width = right - left + 1;
+        int before = top * cols;
+        if (i < before) {
+            return index(i % cols, i / cols);
+        }
+        i -= before;
+        int band = (bottom - top + 1) * (cols - width);
+        if (i < band) {
+            int col = i % (cols - width);
+            return index(col < left ? col : col + width, top + i / (cols - width));
+        }
+        i -= band;
+        return index(i % cols, bottom + 1 + i / cols);
+    }
+
+    // the mine index, brought up to date if mines were removed since
+    const pmr::vector<int> &mineList() {
+        if (mineIndexDirty) {
+            mineCells.clear();
+            for (int i = 0; i < int(cells.size()); ++i) {
+                if ((cells[i] & (CELL_MINE | CELL_BORDER)) == CELL_MINE) {
+                    mineCells.push_back(i);
+                }
+            }
+            mineIndexDirty = false;
+        }
+        return mineCells;
+    }
+
+    // editor: puts a mine on a tile or takes it off, fixing only that tile's
+    // count and its neighbors', so painting never recounts the board
+    void setMine(int index, bool mine) {
+        if ((cells[index] & CELL_BORDER) || bool(cells[index] & CELL_MINE) == mine) return;
+        // the openings change shape, restartSameBoard() labels them again
+        openingsValid = false;
+        minesPending = false;
+        if (mine) {
+            addMineAt(index);
+        }
+        else {
+            removeMineAt(index);
+        }
+        mines = placedMines;
+    }
+
+    void toggleMine(int index) {
+        setMine(index, !(cells[index] & CELL_MINE));
+    }
+
+    // hides every tile and clears the flags but keeps the mines, so an
+    // edited board can be played from the start
+    void restartSameBoard() {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (!(cells[i] & CELL_BORDER)) {
+                cells[i] = (cells[i] | CELL_HIDDEN) & ~CELL_FLAGGED;
+            }
+        }
+        minesPending = false;
+        recount();
+        indexOpenings();
+    }
+
+    // turns one cell into a mine and bumps the counts of its neighbors, so
+    // mines can be added without recounting the whole board
+    void addMineAt(int index) {
+        if (cells[index] & (CELL_MINE | CELL_BORDER)) return;
+        setCell(index, (cells[index] | CELL_MINE) & ~CELL_COUNT);
+        mineCells.push_back(index);
+        for (int k = 0; k < neighborCount; ++k) {
+            int next = neighbor(index, k);
+            if (!(cells[next] & (CELL_MINE | CELL_BORDER))) {
+                cells[next]++;
+            }
+        }
+    }
+
+    // the reverse of addMineAt: the tile takes the count of the mines
+    // around it and its safe neighbors drop by one
+    void removeMineAt(int index) {
+        unsigned char around = 0;
+        for (int k = 0; k < neighborCount; ++k) {
+            int next = neighbor(index, k);
+            // a torus one tile wide or high is its own neighbor
+            if (next == index) continue;
+            if (cells[next] & CELL_MINE) {
+                around++;
+            }
+            else if (!(cells[next] & CELL_BORDER)) {
+                cells[next]--;
+            }
+        }
+        setCell(index, (cells[index] & ~(CELL_MINE | CELL_COUNT)) | around);
+        mineIndexDirty = true;
+    }
+
+    // the sizes the hot loops use, constants for fixed-size boards
+    int colCount() const {
+        return fixedSize ? Cols : cols;
+    }
+    int rowCount() const {
+        return fixedSize ? Rows : rows;
+    }
+    int rowStride() const {
+        return fixedSize ? Cols + 2 : stride;
+    }
+
+    // position of tile (x, y) inside the padded cells
+    int index(int x, int y) const {
+        if (!Layout::rowMajor) {
+            return Layout::index(x + 1, y + 1, stride);
+        }
+        return (y + 1) * rowStride() + x + 1;
+    }
+
+    // tile coordinates of the cell at index
+    sf::Vector2i position(int index) const {
+        sf::Vector2i padded = Layout::position(index, rowStride());
+        return sf::Vector2i(padded.x - 1, padded.y - 1);
+    }
+
+    // index of neighbor k (0 to neighborCount - 1) of the cell at index.
+    // hex boards look up the row parity, the torus wraps the stepped tile
+    // coordinates back onto the board
+    int neighbor(int index, int k) const {
+        if (!Layout::rowMajor) {
+            int step = k < 4 ? k : k + 1;
+            return TiledLayout::step(index, step % 3 - 1, step / 3 - 1, stride);
+        }
+        if (Topology::wraps) {
+            int y = index / rowStride();
+            int x = index - y * rowStride();
+            return this->index(wrapInto(x - 1 + Topology::steps[0][k][0], colCount()),
+                               wrapInto(y - 1 + Topology::steps[0][k][1], rowCount()));
+        }
+        if (Topology::hexRows) {
+            return index + neighborOffsets[(index / rowStride()) & 1][k];
+        }
+        return index + (fixedSize ? neighborOffset(k, Cols + 2) : neighborOffsets[0][k]);
+    }
+
+    // (re)builds an empty grid of hidden tiles inside the border ring
+    void layoutCells() {
+        stride = Layout::layoutStride(colCount() + 2);
+        CellStorage<Cols, Rows>::resize(cells, Layout::cellCount(colCount() + 2, rowCount() + 2));
+        fill(cells.begin(), cells.end(), CELL_BORDER);
+        for (int y = 0; y < rowCount(); ++y) {
+            if (Layout::rowMajor) {
+                fill(cells.begin() + index(0, y), cells.begin() + index(colCount(), y), CELL_HIDDEN);
+                continue;
+            }
+            for (int x = 0; x < colCount(); ++x) {
+                cells[index(x, y)] = CELL_HIDDEN;
+            }
+        }
+        // padded row py holds tile row py - 1, so the parities swap
+        for (int parity = 0; parity < 2; ++parity) {
+            for (int k = 0; k < neighborCount; ++k) {
+                const int *step = Topology::steps[parity ^ 1][k];
+                neighborOffsets[parity][k] = step[1] * stride + step[0];
+            }
+        }
+        openingsValid = false;
+        recount();
+    }
+
+    Tile getTileAt(int x, int y) {
+        return Tile(*this, index(x, y));
+    }
+
+    void setTileAt(int x, int y, unsigned char state) {
+        // ensure x and y are within bounds
+        if (x >= 0 && x < cols && y >= 0 && y < rows) {
+            // set the tile at the specified position
+            setCell(index(x, y), state);
+        }
+    }
+
+    // adds (sign 1) or removes (sign -1) one cell's share of the counters
+    void countCell(unsigned char state, int sign) {
+        if (state & CELL_BORDER) {
+            return;
+        }
+        if (!(state & CELL_HIDDEN)) {
+            revealedCount += sign;
+        }
+        else if (!(state & CELL_MINE)) {
+            hiddenSafe += sign;
+        }
+        if ((state & (CELL_MINE | CELL_FLAGGED)) == (CELL_MINE | CELL_FLAGGED)) {
+            correctFlags += sign;
+        }
+        if (state & CELL_MINE) {
+            placedMines += sign;
+        }
+    }
+
+    // read access shared with BoardSnapshot, for code that runs on either
+    unsigned char cell(int index) const {
+        return cells[index];
+    }
+    int cellCount() const {
+        return int(cells.size());
+    }
+
+    // every single-cell write goes through here to keep the counters live
+    void setCell(int index, unsigned char state) {
+        unsigned char old = cells[index];
+        if (openingsValid && isBlank(old) && ((old ^ state) & (CELL_HIDDEN | CELL_FLAGGED))) {
+            openingTouched[openingOf[index]] = 1;
+        }
+        countCell(old, -1);
+        cells[index] = state;
+        countCell(state, 1);
+    }
+
+    static bool isBlank(unsigned char state) {
+        return !(state & (CELL_MINE | CELL_COUNT | CELL_BORDER));
+    }
+
+    // the opening a blank tile can be revealed through in bulk, or -1 when
+    // the fill has to find it
+    int openingAt(int index) const {
+        if (!openingsValid || !isBlank(cells[index]) || openingTouched[openingOf[index]]) {
+            return -1;
+        }
+        return openingOf[index];
+    }
+
+    // labels the openings with union-find: every blank joins its blank
+    // neighbors above and to the left (the first half of them, which covers
+    // each pair once),
+    // each root being the smallest index in its region, then one pass numbers
+    // the regions and a counting pass lays the member lists out back to back
+    void indexOpenings() {
+        openingsValid = false;
+        if (cells.size() > size_t(OPENING_INDEX_MAX_CELLS)) return;
+
+        int total = int(cells.size());
+        openingOf.assign(total, -1);
+        for (int i = 0; i < total; ++i) {
+            if (isBlank(cells[i])) openingOf[i] = i;
+        }
+        for (int i = 0; i < total; ++i) {
+            if (!isBlank(cells[i])) continue;
+            for (int k = 0; k < neighborCount / 2; ++k) {
+                int other = neighbor(i, k);
+                if (isBlank(cells[other])) {
+                    int a = findOpeningRoot(i);
+                    int b = findOpeningRoot(other);
+                    if (a != b) {
+                        openingOf[max(a, b)] = min(a, b);
+                    }
+                }
+            }
+        }
+
+        // every parent has a smaller index than its child, so in index order
+        // a tile's parent already holds its region's final number
+        int count = 0;
+        for (int i = 0; i < total; ++i) {
+            if (openingOf[i] < 0) continue;
+            openingOf[i] = openingOf[i] == i ? count++ : openingOf[openingOf[i]];
+        }
+
+        openingStart.assign(count + 1, 0);
+        openingTouched.assign(count, 0);
+        for (int pass = 0; pass < 2; ++pass) {
+            if (pass == 1) {
+                for (int k = 0; k < count; ++k) {
+                    openingStart[k + 1] += openingStart[k];
+                }
+                openingMembers.resize(openingStart[count]);
+            }
+            for (int i = 0; i < total; ++i) {
+                unsigned char state = cells[i];
+                if (state & (CELL_MINE | CELL_BORDER)) continue;
+                // a numbered tile belongs to every opening around it
+                int found[8];
+                int seen = 0;
+                if (isBlank(state)) {
+                    found[seen++] = openingOf[i];
+                    // a flag put down before the index was built splits the
+                    // region just like one put down after
+                    if (state & CELL_FLAGGED) {
+                        openingTouched[openingOf[i]] = 1;
+                    }
+                }
+                else {
+                    for (int k = 0; k < neighborCount; ++k) {
+                        int label = openingOf[neighbor(i, k)];
+                        if (label >= 0 && find(found, found + seen, label) == found + seen) {
+                            found[seen++] = label;
+                        }
+                    }
+                }
+                for (int j = 0; j < seen; ++j) {
+                    if (pass == 0) openingStart[found[j] + 1]++;
+                    else openingMembers[openingStart[found[j]]++] = i;
+                }
+            }
+        }
+        // the fill pass advanced every start to the next opening's start
+        for (int k = count; k > 0; --k) {
+            openingStart[k] = openingStart[k - 1];
+        }
+        openingStart[0] = 0;
+        openingsValid = true;
+    }
+
+    int findOpeningRoot(int index) {
+        while (openingOf[index] != index) {
+            // path halving
+            openingOf[index] = openingOf[openingOf[index]];
+            index = openingOf[index];
+        }
+        return index;
+    }
+
+    // opens a hidden, unflagged tile; the reveal loops' fast path for setCell
+    void revealCell(int index) {
+        cells[index] &= ~CELL_HIDDEN;
+        revealedCount++;
+        if (!(cells[index] & CELL_MINE)) {
+            hiddenSafe--;
+        }
+    }
+
+    // rebuilds the counters from scratch after a bulk change to the cells
+    void recount() {
+        hiddenSafe = 0;
+        revealedCount = 0;
+        correctFlags = 0;
+        placedMines = 0;
+        mineCells.clear();
+        mineIndexDirty = false;
+        for (size_t i = 0; i < cells.size(); ++i) {
+            countCell(cells[i], 1);
+            if ((cells[i] & (CELL_MINE | CELL_BORDER)) == CELL_MINE) {
+                mineCells.push_back(int(i));
+            }
+        }
+    }
+
+    void revealAllTiles() {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            cells[i] &= ~CELL_HIDDEN;
+        }
+        recount();
+    }
+
+    void hideAllTiles() {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (!(cells[i] & (CELL_FLAGGED | CELL_BORDER))) {
+                cells[i] |= CELL_HIDDEN;
+            }
+        }
+        recount();
+    }
+
+    // places numMines new mines uniformly at random in time proportional to
+    // the mine count, whatever the density
+    void addMines(int numMines) {
+        int cols = colCount();
+        int rows = rowCount();
+        int total = rows * cols;
+        numMines = min(numMines, total - placedMines);
+        if (numMines <= 0) return;
+        // counts are stale until assignSurroundingMines
+        openingsValid = false;
+
+        if (placedMines == 0) {
+            // Floyd's sampling: each step draws from a range that grows by one,
+            // and a collision takes the new top tile, which can't be taken yet
+            for (int top = total - numMines; top < total; ++top) {
+                int pick = int(rng.below(uint32_t(top) + 1));
+                int cell = index(pick % cols, pick / cols);
+                if (cells[cell] & CELL_MINE) {
+                    cell = index(top % cols, top / cols);
+                }
+                setCell(cell, cells[cell] | CELL_MINE);
+                mineCells.push_back(cell);
+            }
+            return;
+        }
+
+        // some mines are already down: partial Fisher-Yates over the free tiles
+        pmr::vector<int> freeTiles(mineCells.get_allocator());
+        freeTiles.reserve(total - placedMines);
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
+                if (!(cells[index(x, y)] & CELL_MINE)) {
+                    freeTiles.push_back(index(x, y));
+                }
+            }
+        }
+        for (int k = 0; k < numMines; ++k) {
+            int pick = k + int(rng.below(uint32_t(freeTiles.size() - k)));
+            swap(freeTiles[k], freeTiles[pick]);
+            setCell(freeTiles[k], cells[freeTiles[k]] | CELL_MINE);
+            mineCells.push_back(freeTiles[k]);
+        }
+    }
+
+    void assignSurroundingMines(BasicBoard &board) {
+        if (Topology::hexRows) {
+            board.countHexNeighbors();
+            board.indexOpenings();
+            return;
+        }
+        if (Topology::wraps) {
+            // the border ring takes the mine bits from the opposite edges, so
+            // the square kernels count across the seams, then goes back
+            board.setBorderFromOppositeEdges(true);
+            countNeighbors(board.cells.data(), board.colCount(), board.rowCount());
+            board.setBorderFromOppositeEdges(false);
+            board.indexOpenings();
+            return;
+        }
+        if (Layout::rowMajor) {
+            countNeighbors(board.cells.data(), board.colCount(), board.rowCount());
+            board.indexOpenings();
+            return;
+        }
+        // other layouts copy one band of tile rows at a time, plus the row
+        // above and below it, into a row-major scratch grid for the kernels
+        int paddedCols = board.colCount() + 2;
+        int paddedRows = board.rowCount() + 2;
+        vector<unsigned char> band(size_t(paddedCols) * 10);
+        for (int top = 0; top < paddedRows; top += 8) {
+            for (int row = 0; row < 10; ++row) {
+                int py = top + row - 1;
+                unsigned char *line = &band[size_t(row) * paddedCols];
+                for (int px = 0; px < paddedCols; ++px) {
+                    line[px] = py >= 0 && py < paddedRows ? board.cells[Layout::index(px, py, board.stride)] : 0;
+                }
+            }
+            countNeighbors(band.data(), paddedCols - 2, 8);
+            for (int row = 1; row <= 8 && top + row - 1 < paddedRows; ++row) {
+                const unsigned char *line = &band[size_t(row) * paddedCols];
+                for (int px = 1; px < paddedCols - 1; ++px) {
+                    if (!(line[px] & CELL_BORDER)) {
+                        board.cells[Layout::index(px, top + row - 1, board.stride)] = line[px];
+                    }
+                }
+            }
+        }
+        board.indexOpenings();
+    }
+
+    // the square kernels row by row, with the six hex neighbors of the
+    // row's parity; the fixed neighbor count unrolls the sum
+    void countHexNeighbors() {
+        unsigned char *grid = cells.data();
+        for (int py = 1; py <= rowCount(); ++py) {
+            const int *offsets = neighborOffsets[py & 1];
+            unsigned char *row = grid + py * rowStride();
+            for (int px = 1; px <= colCount(); ++px) {
+                unsigned char sum = 0;
+                for (int k = 0; k < neighborCount; ++k) {
+                    sum += row[px + offsets[k]] & CELL_MINE;
+                }
+                unsigned char cell = row[px];
+                row[px] = (cell & ~CELL_COUNT) | ((cell & CELL_MINE) ? 0 : sum >> 4);
+            }
+        }
+    }
+
+    // copies each edge's mine bits onto the border cells beyond the opposite
+    // edge (corners included), or clears them again
+    void setBorderFromOppositeEdges(bool copy) {
+        int paddedCols = colCount() + 2;
+        int paddedRows = rowCount() + 2;
+        for (int py = 0; py < paddedRows; ++py) {
+            bool edgeRow = py == 0 || py == paddedRows - 1;
+            for (int px = 0; px < paddedCols; px += edgeRow ? 1 : paddedCols - 1) {
+                int ring = py * rowStride() + px;
+                int source = index(wrapInto(px - 1, colCount()), wrapInto(py - 1, rowCount()));
+                cells[ring] = CELL_BORDER | (copy ? cells[source] & CELL_MINE : 0);
+            }
+        }
+    }
+};
+
+typedef BasicBoard<> Board;
+typedef Board::Tile Tile;
+
+inline int popcount64(uint64_t word) {
+#if defined(_MSC_VER)
+    return (int)__popcnt64(word);
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+// alternate board backend: every state is a bitplane of 64-bit words,
+// one bit per cell, each row padded out to a whole number of words
+class BitBoard {
+public:
+    int rows;
+    int cols;
+    int mines;
+    int wordsPerRow;
+    vector<uint64_t> minePlane;
+    vector<uint64_t> hiddenPlane;
+    vector<uint64_t> flaggedPlane;
+    // bit-sliced surrounding mine counts, countPlanes[k] holds bit k of every count
+    vector<uint64_t> countPlanes[4];
+    uint64_t seed;
+    Pcg32 rng;
+
+    // the same seed gives the same mines as a Board of the same size
+    BitBoard(int numRows, int numCols, int numMines, uint64_t boardSeed = randomSeed()) : rows(numRows), cols(numCols), mines(numMines),
+                                                        wordsPerRow((numCols + 63) / 64), seed(boardSeed), rng(boardSeed) {
+        size_t words = size_t(rows) * wordsPerRow;
+        minePlane.assign(words, 0);
+        flaggedPlane.assign(words, 0);
+        hiddenPlane.assign(words, 0);
+        for (int k = 0; k < 4; ++k) {
+            countPlanes[k].assign(words, 0);
+        }
+        hideAllTiles();
+        addMines(mines);
+    }
+
+    // mask of the bits in a row word that lie on the board
+    uint64_t validMask(int word) const {
+        int remaining = cols - word * 64;
+        return remaining >= 64 ? ~uint64_t(0) : (uint64_t(1) << remaining) - 1;
+    }
+
+    bool testBit(const vector<uint64_t> &plane, int x, int y) const {
+        return (plane[size_t(y) * wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    void setBit(vector<uint64_t> &plane, int x, int y, bool value) {
+        uint64_t &word = plane[size_t(y) * wordsPerRow + (x >> 6)];
+        uint64_t bit = uint64_t(1) << (x & 63);
+        if (value) word |= bit;
+        else word &= ~bit;
+    }
+
+    bool isMine(int x, int y) const {
+        return testBit(minePlane, x, y);
+    }
+    bool isHidden(int x, int y) const {
+        return testBit(hiddenPlane, x, y);
+    }
+    void setHidden(int x, int y, bool value) {
+        setBit(hiddenPlane, x, y, value);
+    }
+    bool isFlagged(int x, int y) const {
+        return testBit(flaggedPlane, x, y);
+    }
+    void setFlagged(int x, int y, bool value) {
+        setBit(flaggedPlane, x, y, value);
+    }
+    unsigned int getSurroundingMines(int x, int y) const {
+        unsigned int count = 0;
+        for (int k = 0; k < 4; ++k) {
+            count |= unsigned(testBit(countPlanes[k], x, y)) << k;
+        }
+        return count;
+    }
+
+    void revealAllTiles() {
+        std::fill(hiddenPlane.begin(), hiddenPlane.end(), 0);
+    }
+
+    void hideAllTiles() {
+        for (int y = 0; y < rows; ++y) {
+            for (int w = 0; w < wordsPerRow; ++w) {
+                size_t i = size_t(y) * wordsPerRow + w;
+                hiddenPlane[i] |= ~flaggedPlane[i] & validMask(w);
+            }
+        }
+    }
+
+    // Floyd's sampling over the cell indices, same as Board::addMines
+    void addMines(int numMines) {
+        int total = rows * cols;
+        int placed = countMines();
+        numMines = min(numMines, total - placed);
+        if (numMines <= 0) return;
+
+        if (placed == 0) {
+            for (int top = total - numMines; top < total; ++top) {
+                int index = int(rng.below(uint32_t(top) + 1));
+                if (isMine(index % cols, index / cols)) {
+                    index = top;
+                }
+                setBit(minePlane, index % cols, index / cols, true);
+            }
+            return;
+        }
+
+        vector<int> freeTiles;
+        freeTiles.reserve(total - placed);
+        for (int i = 0; i < total; ++i) {
+            if (!isMine(i % cols, i / cols)) {
+                freeTiles.push_back(i);
+            }
+        }
+        for (int k = 0; k < numMines; ++k) {
+            int pick = k + int(rng.below(uint32_t(freeTiles.size() - k)));
+            swap(freeTiles[k], freeTiles[pick]);
+            setBit(minePlane, freeTiles[k] % cols, freeTiles[k] / cols, true);
+        }
+    }
+
+    int countMines() const {
+        int total = 0;
+        for (size_t i = 0; i < minePlane.size(); ++i) {
+            total += popcount64(minePlane[i]);
+        }
+        return total;
+    }
+
+    // won once every safe cell has been revealed
+    bool checkGameWon() const {
+        for (size_t i = 0; i < hiddenPlane.size(); ++i) {
+            if (hiddenPlane[i] & ~minePlane[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // counts all eight neighbor planes at once with bit-sliced adders,
+    // 64 cells per word operation; mines keep a count of zero like Board
+    void assignSurroundingMines() {
+        vector<uint64_t> neighbors[8];
+        for (int k = 0; k < 8; ++k) {
+            neighbors[k].assign(wordsPerRow, 0);
+        }
+
+        for (int y = 0; y < rows; ++y) {
+            int plane = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                int ny = y + dy;
+                bool inside = ny >= 0 && ny < rows;
+                const uint64_t *row = inside ? &minePlane[size_t(ny) * wordsPerRow] : nullptr;
+                for (int w = 0; w < wordsPerRow; ++w) {
+                    uint64_t center = inside ? row[w] : 0;
+                    uint64_t before = inside && w > 0 ? row[w - 1] : 0;
+                    uint64_t after = inside && w + 1 < wordsPerRow ? row[w + 1] : 0;
+                    // neighbor to the left lands on this bit when shifted up, and vice versa
+                    neighbors[plane][w] = (center << 1) | (before >> 63);
+                    neighbors[plane + 1][w] = (center >> 1) | (after << 63);
+                    if (dy != 0) {
+                        neighbors[plane + 2][w] = center;
+                    }
+                }
+                plane += dy != 0 ? 3 : 2;
+            }
+
+            for (int w = 0; w < wordsPerRow; ++w) {
+                uint64_t b0 = 0, b1 = 0, b2 = 0, b3 = 0;
+                for (int k = 0; k < 8; ++k) {
+                    // ripple-carry increment of the 4-bit counters by one plane
+                    uint64_t carry = b0 & neighbors[k][w];
+                    b0 ^= neighbors[k][w];
+                    uint64_t carry2 = b1 & carry;
+                    b1 ^= carry;
+                    uint64_t carry3 = b2 & carry2;
+                    b2 ^= carry2;
+                    b3 |= carry3;
+                }
+                size_t i = size_t(y) * wordsPerRow + w;
+                uint64_t safe = ~minePlane[i] & validMask(w);
+                countPlanes[0][i] = b0 & safe;
+                countPlanes[1][i] = b1 & safe;
+                countPlanes[2][i] = b2 & safe;
+                countPlanes[3][i] = b3 & safe;
+            }
+        }
+    }
+
+    // expands the planes into a byte board so it can be played and drawn;
+    // the board takes the seed too, so its id rebuilds the same mines. the
+    // mines are already down, so the board becomes an eager one whatever
+    // it was before
+    template <class BoardT>
+    void copyTo(BoardT &board) const {
+        board.rows = rows;
+        board.cols = cols;
+        board.mines = mines;
+        board.reseed(seed);
+        board.placement = PLACE_MINES_NOW;
+        board.minesPending = false;
+        board.safeX = -1;
+        board.safeY = -1;
+        board.layoutCells();
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
+                unsigned char state = (unsigned char)getSurroundingMines(x, y);
+                if (isMine(x, y)) state |= CELL_MINE;
+                if (isHidden(x, y)) state |= CELL_HIDDEN;
+                if (isFlagged(x, y)) state |= CELL_FLAGGED;
+                board.cells[board.index(x, y)] = state;
+            }
+        }
+        board.recount();
+    }
+};
+
+// side of the square chunks a ChunkedBoard is generated and stored in
+const int CHUNK_SIZE = 64;
+const int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;
+
+// splitmix64 finalizer, turns a board seed and chunk position into an
+// independent seed for that chunk
+inline uint64_t mixSeed(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+// board without a fixed size: 64x64 chunks are generated from the seed the
+// first time they are touched and kept in a hash map, so memory follows the
+// explored area rather than the whole grid. every chunk holds the same number
+// of mines, which makes each chunk a pure function of the seed and its position
+class ChunkedBoard {
+public:
+    struct Chunk {
+        // row-major, same packed state bytes as Board, no border ring
+        unsigned char cells[CHUNK_CELLS];
+        int hiddenSafe;
+        // hidden or flagged state differs from a freshly generated chunk
+        bool dirty;
+        uint64_t lastUse;
+    };
+
+    // an evicted chunk: the cells whose hidden or flagged bits differ from a
+    // baseline, either freshly generated or fully resolved (every safe cell
+    // open); each change is the cell offset with the toggled bits shifted above it
+    struct StoredChunk {
+        bool resolvedBase;
+        vector<uint16_t> changes;
+    };
+
+    // handle onto one cell of a live chunk, only valid until the next compact()
+    class Tile {
+    public:
+        Tile(ChunkedBoard &owner, Chunk &cellChunk, int cellOffset) : board(owner), chunk(cellChunk), offset(cellOffset) {}
+
+        bool isHidden() const {
+            return (chunk.cells[offset] & CELL_HIDDEN) != 0;
+        }
+        void setHidden(bool value) {
+            unsigned char state = chunk.cells[offset];
+            board.setCell(chunk, offset, value ? state | CELL_HIDDEN : state & ~CELL_HIDDEN);
+        }
+        bool isFlagged() const {
+            return (chunk.cells[offset] & CELL_FLAGGED) != 0;
+        }
+        void setFlagged(bool value) {
+            unsigned char state = chunk.cells[offset];
+            board.setCell(chunk, offset, value ? state | CELL_FLAGGED : state & ~CELL_FLAGGED);
+        }
+        bool isMine() const {
+            return (chunk.cells[offset] & CELL_MINE) != 0;
+        }
+        unsigned int getSurroundingMines() const {
+            return chunk.cells[offset] & CELL_COUNT;
+        }
+
+    private:
+        ChunkedBoard &board;
+        Chunk &chunk;
+        int offset;
+    };
+
+    int minesPerChunk;
+    uint64_t seed;
+    unordered_map<uint64_t, unique_ptr<Chunk>> chunks;
+    unordered_map<uint64_t, StoredChunk> stored;
+    // counters over every chunk, live or stored
+    int revealedCount;
+    int flagCount;
+    int correctFlags;
+    int minesRevealed;
+    // blank tiles whose neighbors a capped reveal didn't get to yet
+    vector<sf::Vector2i> frontier;
+
+    ChunkedBoard(int numMinesPerChunk, uint64_t boardSeed = randomSeed())
+        : minesPerChunk(max(0, min(numMinesPerChunk, CHUNK_CELLS))), seed(boardSeed), revealedCount(0),
+          flagCount(0), correctFlags(0), minesRevealed(0), useClock(0), cachedKey(0), cachedChunk(nullptr) {}
+
+    // chunk coordinate of a tile coordinate, rounding toward negative infinity
+    static int chunkCoord(int value) {
+        return value >= 0 ? value / CHUNK_SIZE : -((-value - 1) / CHUNK_SIZE) - 1;
+    }
+
+    static uint64_t chunkKey(int chunkX, int chunkY) {
+        return (uint64_t(uint32_t(chunkX)) << 32) | uint32_t(chunkY);
+    }
+
+    // mine offsets of a chunk, drawn with Floyd's sampling from the chunk's own seed
+    void chunkMines(int chunkX, int chunkY, vector<int> &mineOffsets) const {
+        Pcg32 chunkRng(mixSeed(seed ^ mixSeed(chunkKey(chunkX, chunkY))));
+        vector<bool> taken(CHUNK_CELLS, false);
+        mineOffsets.clear();
+        for (int top = CHUNK_CELLS - minesPerChunk; top < CHUNK_CELLS; ++top) {
+            int pick = int(chunkRng.below(uint32_t(top) + 1));
+            if (taken[pick]) {
+                pick = top;
+            }
+            taken[pick] = true;
+            mineOffsets.push_back(pick);
+        }
+    }
+
+    // builds a fresh chunk: its mines plus the mines along the edges of its
+    // eight neighbors go into a padded buffer, which the usual kernels count
+    void generate(int chunkX, int chunkY, Chunk &chunk) const {
+        const int stride = CHUNK_SIZE + 2;
+        vector<unsigned char> padded(size_t(stride) * stride, 0);
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            fill(padded.begin() + (y + 1) * stride + 1, padded.begin() + (y + 1) * stride + 1 + CHUNK_SIZE, CELL_HIDDEN);
+        }
+
+        vector<int> mineOffsets;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                chunkMines(chunkX + dx, chunkY + dy, mineOffsets);
+                for (size_t i = 0; i < mineOffsets.size(); ++i) {
+                    int x = mineOffsets[i] % CHUNK_SIZE + dx * CHUNK_SIZE;
+                    int y = mineOffsets[i] / CHUNK_SIZE + dy * CHUNK_SIZE;
+                    if (x >= -1 && x <= CHUNK_SIZE && y >= -1 && y <= CHUNK_SIZE) {
+                        padded[(y + 1) * stride + x + 1] |= CELL_MINE;
+                    }
+                }
+            }
+        }
+        countNeighbors(padded.data(), CHUNK_SIZE, CHUNK_SIZE);
+
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            copy(padded.begin() + (y + 1) * stride + 1, padded.begin() + (y + 1) * stride + 1 + CHUNK_SIZE,
+                 chunk.cells + y * CHUNK_SIZE);
+        }
+        chunk.hiddenSafe = CHUNK_CELLS - minesPerChunk;
+        chunk.dirty = false;
+    }
+
+    // the live chunk at a chunk position, generated or restored on first use
+    Chunk &chunkAt(int chunkX, int chunkY) {
+        uint64_t key = chunkKey(chunkX, chunkY);
+        if (cachedChunk && cachedKey == key) {
+            return *cachedChunk;
+        }
+
+        unordered_map<uint64_t, unique_ptr<Chunk>>::iterator found = chunks.find(key);
+        Chunk *chunk;
+        if (found != chunks.end()) {
+            chunk = found->second.get();
+        }
+        else {
+            chunk = new Chunk;
+            chunks[key].reset(chunk);
+            generate(chunkX, chunkY, *chunk);
+            unordered_map<uint64_t, StoredChunk>::iterator saved = stored.find(key);
+            if (saved != stored.end()) {
+                restore(*chunk, saved->second);
+                stored.erase(saved);
+            }
+        }
+        chunk->lastUse = ++useClock;
+        cachedKey = key;
+        cachedChunk = chunk;
+        return *chunk;
+    }
+
+    Tile getTileAt(int x, int y) {
+        int chunkX = chunkCoord(x);
+        int chunkY = chunkCoord(y);
+        Chunk &chunk = chunkAt(chunkX, chunkY);
+        return Tile(*this, chunk, (y - chunkY * CHUNK_SIZE) * CHUNK_SIZE + x - chunkX * CHUNK_SIZE);
+    }
+
+    // adds (sign 1) or removes (sign -1) one cell's share of the counters
+    void countCell(Chunk &chunk, unsigned char state, int sign) {
+        if (!(state & CELL_HIDDEN)) {
+            revealedCount += sign;
+            if (state & CELL_MINE) {
+                minesRevealed += sign;
+            }
+        }
+        else if (!(state & CELL_MINE)) {
+            chunk.hiddenSafe += sign;
+        }
+        if (state & CELL_FLAGGED) {
+            flagCount += sign;
+            if (state & CELL_MINE) {
+                correctFlags += sign;
+            }
+        }
+    }
+
+    void setCell(Chunk &chunk, int offset, unsigned char state) {
+        countCell(chunk, chunk.cells[offset], -1);
+        chunk.cells[offset] = state;
+        countCell(chunk, state, 1);
+        chunk.dirty = true;
+    }
+
+    // same rules as revealTiles, the opening just crosses chunk edges. on
+    // sparse boards an opening can be unbounded, so the fill stops once about
+    // maxTiles are open and leaves the rest in frontier for continueReveal
+    vector<sf::Vector2i> reveal(int x, int y, size_t maxTiles = 1 << 20) {
+        vector<sf::Vector2i> revealed;
+        Tile tile = getTileAt(x, y);
+        if (!tile.isHidden() || tile.isFlagged()) {
+            return revealed;
+        }
+        tile.setHidden(false);
+        revealed.push_back(sf::Vector2i(x, y));
+        if (!tile.isMine() && tile.getSurroundingMines() == 0) {
+            frontier.push_back(sf::Vector2i(x, y));
+            continueReveal(maxTiles, revealed);
+        }
+        return revealed;
+    }
+
+    void continueReveal(size_t maxTiles, vector<sf::Vector2i> &revealed) {
+        while (!frontier.empty() && revealed.size() < maxTiles) {
+            sf::Vector2i tile = frontier.back();
+            frontier.pop_back();
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int nx = tile.x + dx;
+                    int ny = tile.y + dy;
+                    int chunkX = chunkCoord(nx);
+                    int chunkY = chunkCoord(ny);
+                    Chunk &chunk = chunkAt(chunkX, chunkY);
+                    int offset = (ny - chunkY * CHUNK_SIZE) * CHUNK_SIZE + nx - chunkX * CHUNK_SIZE;
+                    unsigned char cell = chunk.cells[offset];
+                    if (isOpenable(cell)) {
+                        setCell(chunk, offset, cell & ~CELL_HIDDEN);
+                        revealed.push_back(sf::Vector2i(nx, ny));
+                        if (isOpenableBlank(cell)) {
+                            frontier.push_back(sf::Vector2i(nx, ny));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // evicts the least recently used chunks until at most maxLiveChunks stay
+    // in memory: untouched chunks are simply dropped since they regenerate
+    // from the seed, the rest shrink to their changes from a baseline
+    void compact(size_t maxLiveChunks) {
+        cachedChunk = nullptr;
+        if (chunks.size() <= maxLiveChunks) return;
+
+        vector<pair<uint64_t, uint64_t>> byAge;
+        byAge.reserve(chunks.size());
+        for (unordered_map<uint64_t, unique_ptr<Chunk>>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+            byAge.push_back(make_pair(it->second->lastUse, it->first));
+        }
+        sort(byAge.begin(), byAge.end());
+
+        size_t evictions = chunks.size() - maxLiveChunks;
+        for (size_t i = 0; i < evictions; ++i) {
+            uint64_t key = byAge[i].second;
+            Chunk &chunk = *chunks[key];
+            if (chunk.dirty) {
+                StoredChunk saved;
+                compress(chunk, saved);
+                if (saved.resolvedBase || !saved.changes.empty()) {
+                    stored[key].changes.swap(saved.changes);
+                    stored[key].resolvedBase = saved.resolvedBase;
+                }
+            }
+            chunks.erase(key);
+        }
+    }
+
+    // picks whichever baseline leaves fewer changed cells; a fully resolved
+    // chunk usually comes down to its flags
+    void compress(const Chunk &chunk, StoredChunk &saved) const {
+        const unsigned char tracked = CELL_HIDDEN | CELL_FLAGGED;
+        int freshChanges = 0;
+        int resolvedChanges = 0;
+        for (int i = 0; i < CHUNK_CELLS; ++i) {
+            unsigned char cell = chunk.cells[i];
+            freshChanges += ((cell ^ CELL_HIDDEN) & tracked) != 0;
+            resolvedChanges += ((cell ^ ((cell & CELL_MINE) ? CELL_HIDDEN : 0)) & tracked) != 0;
+        }
+
+        saved.resolvedBase = resolvedChanges < freshChanges;
+        saved.changes.clear();
+        saved.changes.reserve(min(freshChanges, resolvedChanges));
+        for (int i = 0; i < CHUNK_CELLS; ++i) {
+            unsigned char cell = chunk.cells[i];
+            unsigned char base = saved.resolvedBase && !(cell & CELL_MINE) ? 0 : CELL_HIDDEN;
+            unsigned char changed = (cell ^ base) & tracked;
+            if (changed) {
+                saved.changes.push_back(uint16_t(i | (changed << 7)));
+            }
+        }
+    }
+
+    // applies stored changes on top of a freshly generated chunk
+    void restore(Chunk &chunk, const StoredChunk &saved) const {
+        if (saved.resolvedBase) {
+            for (int i = 0; i < CHUNK_CELLS; ++i) {
+                if (!(chunk.cells[i] & CELL_MINE)) {
+                    chunk.cells[i] &= ~CELL_HIDDEN;
+                }
+            }
+        }
+        for (size_t i = 0; i < saved.changes.size(); ++i) {
+            chunk.cells[saved.changes[i] & (CHUNK_CELLS - 1)] ^= (saved.changes[i] >> 7) & (CELL_HIDDEN | CELL_FLAGGED);
+        }
+        chunk.hiddenSafe = 0;
+        for (int i = 0; i < CHUNK_CELLS; ++i) {
+            chunk.hiddenSafe += (chunk.cells[i] & (CELL_HIDDEN | CELL_MINE)) == CELL_HIDDEN;
+        }
+        chunk.dirty = true;
+    }
+
+    // rough heap footprint of the live and stored chunks
+    size_t memoryUse() const {
+        size_t bytes = chunks.size() * (sizeof(Chunk) + sizeof(uint64_t) + sizeof(void *) * 2);
+        for (unordered_map<uint64_t, StoredChunk>::const_iterator it = stored.begin(); it != stored.end(); ++it) {
+            bytes += sizeof(StoredChunk) + sizeof(uint64_t) + it->second.changes.capacity() * sizeof(uint16_t);
+        }
+        return bytes;
+    }
+
+private:
+    uint64_t useClock;
+    // the last chunk looked up, most neighbor visits stay inside one chunk
+    uint64_t cachedKey;
+    Chunk *cachedChunk;
+};
+
+// cells per copy-on-write chunk of a BoardSnapshot
+const int SNAPSHOT_CHUNK_CELLS = 4096;
+
+// persistent copy of a board's cells for solvers and analysis that fork a
+// position many times: the padded cells are cut into chunks shared between
+// snapshots, and the chunk table itself is shared too, so copying a snapshot
+// only copies one pointer. the first write after a fork copies the table,
+// and each chunk is copied the first time it is written; chunks and tables
+// held by more than one snapshot are never written, so any number of
+// threads can read, fork and play their own copies of a common snapshot.
+// works on row-major boards that don't wrap, with their neighbor offsets
+class BoardSnapshot {
 public:
-    bool hidden;
-    bool flagged;
-    sf::Vector2i position;
-    unsigned int surrounding_mines;
+    typedef array<unsigned char, SNAPSHOT_CHUNK_CELLS> Chunk;
+    typedef vector<shared_ptr<Chunk>> ChunkTable;
 
-    Tile(sf::Vector2i pos) : hidden(true), flagged(false), position(pos), surrounding_mines(0) {}
+    int rows;
+    int cols;
+    int mines;
+    int stride;
+    int neighborCount;
+    bool hexRows;
+    int neighborOffsets[2][8];
+    int hiddenSafe;
+    int revealedCount;
+    shared_ptr<ChunkTable> chunks;
+
+    template <class BoardT>
+    explicit BoardSnapshot(const BoardT &board)
+        : rows(board.rowCount()), cols(board.colCount()), mines(board.mines), stride(board.rowStride()),
+          neighborCount(BoardT::neighborCount), hexRows(BoardT::CellTopology::hexRows),
+          hiddenSafe(board.hiddenSafe), revealedCount(board.revealedCount), chunks(make_shared<ChunkTable>()) {
+        static_assert(BoardT::CellLayout::rowMajor && !BoardT::CellTopology::wraps,
+                      "snapshots step through neighbors by fixed offsets");
+        for (int parity = 0; parity < 2; ++parity) {
+            for (int k = 0; k < neighborCount; ++k) {
+                neighborOffsets[parity][k] = board.neighborOffsets[parity][k];
+            }
+        }
+        size_t total = board.cells.size();
+        for (size_t start = 0; start < total; start += SNAPSHOT_CHUNK_CELLS) {
+            shared_ptr<Chunk> chunk = make_shared<Chunk>();
+            size_t count = min(total - start, size_t(SNAPSHOT_CHUNK_CELLS));
+            copy(board.cells.begin() + start, board.cells.begin() + start + count, chunk->begin());
+            fill(chunk->begin() + count, chunk->end(), CELL_BORDER);
+            chunks->push_back(chunk);
+        }
+    }
 
-    virtual ~Tile() {}
+    unsigned char cell(int index) const {
+        return (*(*chunks)[index / SNAPSHOT_CHUNK_CELLS])[index % SNAPSHOT_CHUNK_CELLS];
+    }
 
-    bool isHidden() const {
-        return hidden;
+    // every chunk is whole, the cells past the board's end are border
+    int cellCount() const {
+        return int(chunks->size()) * SNAPSHOT_CHUNK_CELLS;
     }
-    void setHidden(bool value) {
-        hidden = value;
+
+    int index(int x, int y) const {
+        return (y + 1) * stride + x + 1;
     }
-    bool isFlagged() const {
-        return flagged;
+
+    sf::Vector2i position(int index) const {
+        return sf::Vector2i(index % stride - 1, index / stride - 1);
     }
-    void setFlagged(bool value) {
-        flagged = value;
+
+    int neighbor(int index, int k) const {
+        return index + neighborOffsets[hexRows ? (index / stride) & 1 : 0][k];
     }
-    sf::Vector2i getPosition() const {
-        return position;
+
+    // writes one cell, copying the table and the chunk first if another
+    // snapshot still holds them
+    void setCell(int index, unsigned char state) {
+        unsigned char &target = writableCell(index);
+        unsigned char old = target;
+        target = state;
+        if (!(old & CELL_MINE)) {
+            hiddenSafe += (state & CELL_HIDDEN ? 1 : 0) - (old & CELL_HIDDEN ? 1 : 0);
+        }
+        revealedCount += (old & CELL_HIDDEN ? 1 : 0) - (state & CELL_HIDDEN ? 1 : 0);
     }
-};
 
-class Mine : public Tile {
-public:
-    Mine(sf::Vector2i pos) : Tile(pos) {}
+    // the board's fill on the snapshot: opens the tile and, when it's blank,
+    // its opening; returns how many tiles were opened
+    int reveal(int x, int y) {
+        if (x < 0 || x >= cols || y < 0 || y >= rows || !isOpenable(cell(index(x, y)))) {
+            return 0;
+        }
+        int start = index(x, y);
+        setCell(start, cell(start) & ~CELL_HIDDEN);
+        int opened = 1;
+        if (!isOpenableBlank(cell(start) | CELL_HIDDEN)) {
+            return opened;
+        }
+
+        vector<int> blanks(1, start);
+        while (!blanks.empty()) {
+            int current = blanks.back();
+            blanks.pop_back();
+            for (int k = 0; k < neighborCount; ++k) {
+                int next = neighbor(current, k);
+                unsigned char state = cell(next);
+                if (isOpenable(state)) {
+                    setCell(next, state & ~CELL_HIDDEN);
+                    opened++;
+                    if (isOpenableBlank(state)) {
+                        blanks.push_back(next);
+                    }
+                }
+            }
+        }
+        return opened;
+    }
+
+    // writes the snapshot back into a board of the same size and shape
+    template <class BoardT>
+    void copyTo(BoardT &board) const {
+        for (size_t i = 0; i < board.cells.size(); ++i) {
+            board.cells[i] = cell(int(i));
+        }
+        board.recount();
+        board.indexOpenings();
+    }
+
+private:
+    // use_count() is only a relaxed read: the acquire fence after seeing 1
+    // orders our writes after everything the last other owner did before
+    // letting go, so it never sees its chunk change under it
+    template <class T>
+    static bool ownedAlone(const shared_ptr<T> &pointer) {
+        if (pointer.use_count() != 1) return false;
+        atomic_thread_fence(memory_order_acquire);
+        return true;
+    }
+
+    unsigned char &writableCell(int index) {
+        if (!ownedAlone(chunks)) {
+            chunks = make_shared<ChunkTable>(*chunks);
+        }
+        shared_ptr<Chunk> &chunk = (*chunks)[index / SNAPSHOT_CHUNK_CELLS];
+        if (!ownedAlone(chunk)) {
+            chunk = make_shared<Chunk>(*chunk);
+        }
+        return (*chunk)[index % SNAPSHOT_CHUNK_CELLS];
+    }
 };
 
-class Board {
+// 3^dims - 1, the neighbors of a cell in dims dimensions
+constexpr int cubeNeighbors(int dims) {
+    return dims == 0 ? 0 : 3 * (cubeNeighbors(dims - 1) + 1) - 1;
+}
+
+// board with any number of dimensions, three for layered play: one flat
+// padded grid with axis 0 fastest and a border shell all round, so the
+// 3^Dims - 1 neighbors of a tile are fixed index offsets. counts reach 26 in
+// 3D, past the count bits, so they live in a byte plane of their own
+template <int Dims>
+class VolumeBoard {
 public:
-    int rows;
-    int cols;
-    int mines;
-    vector<std::vector<Tile*>> grid;
+    static const int neighborCount = cubeNeighbors(Dims);
+    typedef array<int, Dims> Coords;
 
-    // constructor
-    Board(int numRows, int numCols, int numMines) : rows(numRows), cols(numCols), mines(numMines) {
-        for (int i = 0; i < numRows; ++i) {
-            vector<Tile*> row;
-            for (int j = 0; j < numCols; ++j) {
-                row.push_back(new Tile(sf::Vector2i(j, i)));
-            }
-            grid.push_back(row);
+    Coords size;
+    int mines;
+    // padded cells per step along each axis
+    Coords strides;
+    // state bits as in Board, with the count bits left clear
+    pmr::vector<unsigned char> cells;
+    pmr::vector<unsigned char> counts;
+    int neighborOffsets[neighborCount];
+    // live counters, as on Board
+    int hiddenSafe;
+    int revealedCount;
+    int placedMines;
+    uint64_t seed;
+    Pcg32 rng;
+    // deferred boards get their mines on the first reveal, as on Board
+    bool minesPending;
+
+    VolumeBoard(const Coords &boardSize, int numMines, uint64_t boardSeed = randomSeed(),
+                pmr::memory_resource *resource = pmr::get_default_resource(),
+                MinePlacement minePlacement = PLACE_MINES_NOW)
+        : size(boardSize), mines(numMines), cells(resource), counts(resource), seed(boardSeed), rng(boardSeed),
+          minesPending(minePlacement == PLACE_MINES_ON_FIRST_REVEAL) {
+        layoutCells();
+        if (!minesPending) {
+            addMines(mines);
+            assignSurroundingMines();
         }
-        addMines(mines);
     }
 
-    ~Board() {
-        for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                delete grid[i][j];
+    // puts pending mines down away from the first tile opened: the tile and
+    // its neighbors stay clear, or just the tile when the board is too dense.
+    // Floyd's sampling runs over the other tiles' numbers, each pick skipping
+    // past the kept-clear ones below it
+    void placeMinesAround(const Coords &at) {
+        if (!minesPending) return;
+        minesPending = false;
+
+        vector<int> clear;
+        for (int combo = 0; combo <= neighborCount; ++combo) {
+            int n = 0;
+            int scale = 1;
+            bool inside = true;
+            for (int d = 0, digits = combo; d < Dims; ++d, digits /= 3) {
+                int coord = at[d] + digits % 3 - 1;
+                inside = inside && coord >= 0 && coord < size[d];
+                n += coord * scale;
+                scale *= size[d];
+            }
+            if (inside) {
+                clear.push_back(n);
             }
         }
+        int total = tileCount();
+        if (mines > total - int(clear.size())) {
+            int n = 0;
+            for (int d = Dims - 1; d >= 0; --d) {
+                n = n * size[d] + at[d];
+            }
+            clear.assign(1, n);
+        }
+        sort(clear.begin(), clear.end());
+
+        int slots = total - int(clear.size());
+        int numMines = min(mines, slots);
+        for (int top = slots - numMines; top < slots; ++top) {
+            int cell = tileIndex(skipClear(int(rng.below(uint32_t(top) + 1)), clear));
+            if (cells[cell] & CELL_MINE) {
+                cell = tileIndex(skipClear(top, clear));
+            }
+            cells[cell] |= CELL_MINE;
+            placedMines++;
+            hiddenSafe--;
+        }
+        assignSurroundingMines();
     }
 
-    Tile* getTileAt(int x, int y) const {
-        return grid[y][x];
+    // the slot-th tile number that isn't in the sorted list clear
+    static int skipClear(int slot, const vector<int> &clear) {
+        for (size_t i = 0; i < clear.size() && clear[i] <= slot; ++i) {
+            slot++;
+        }
+        return slot;
     }
 
-    void setTileAt(int x, int y, Tile* tile) {
-        // ensure x and y are within bounds
-        if (x >= 0 && x < cols && y >= 0 && y < rows) {
-            // set the tile at the specified position
-            grid[x][y] = tile;
+    int tileCount() const {
+        int total = 1;
+        for (int d = 0; d < Dims; ++d) {
+            total *= size[d];
         }
+        return total;
     }
 
-    void revealAllTiles() {
-        int rows = this->rows;
-        int cols = this->cols;
+    // position of a tile inside the padded cells
+    int index(const Coords &at) const {
+        int result = 0;
+        for (int d = 0; d < Dims; ++d) {
+            result += (at[d] + 1) * strides[d];
+        }
+        return result;
+    }
 
-        for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                Tile* tile = this->grid[i][j];
-                tile->setHidden(false);
-            }
+    // the n-th tile with axis 0 fastest
+    int tileIndex(int n) const {
+        Coords at;
+        for (int d = 0; d < Dims; ++d) {
+            at[d] = n % size[d];
+            n /= size[d];
         }
+        return index(at);
     }
 
-    void hideAllTiles() {
-        int rows = this->rows;
-        int cols = this->cols;
+    // an empty grid of hidden tiles inside the border shell; padded
+    // coordinates are stepped like an odometer instead of divided out
+    void layoutCells() {
+        size_t total = 1;
+        for (int d = 0; d < Dims; ++d) {
+            strides[d] = int(total);
+            total *= size[d] + 2;
+        }
+        cells.assign(total, CELL_BORDER);
+        counts.assign(total, 0);
+
+        Coords at = {};
+        for (size_t i = 0; i < total; ++i) {
+            bool inside = true;
+            for (int d = 0; d < Dims; ++d) {
+                inside = inside && at[d] >= 1 && at[d] <= size[d];
+            }
+            if (inside) {
+                cells[i] = CELL_HIDDEN;
+            }
+            for (int d = 0; d < Dims && ++at[d] == size[d] + 2; ++d) {
+                at[d] = 0;
+            }
+        }
 
-        for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                Tile* tile = this->grid[i][j];
-                if (!tile->flagged) {
-                    tile->setHidden(true);
-                }
+        // every combination of -1, 0, 1 steps along the axes but staying put
+        int k = 0;
+        for (int combo = 0; combo <= neighborCount; ++combo) {
+            int offset = 0;
+            for (int d = 0, digits = combo; d < Dims; ++d, digits /= 3) {
+                offset += (digits % 3 - 1) * strides[d];
+            }
+            if (offset != 0) {
+                neighborOffsets[k++] = offset;
             }
         }
+
+        hiddenSafe = tileCount();
+        revealedCount = 0;
+        placedMines = 0;
     }
 
+    // Floyd's sampling over the tiles, as Board::addMines
     void addMines(int numMines) {
-        int addedMines = 0;
-        while (addedMines < numMines) {
-            int x = rand() % cols; // random column index
-            int y = rand() % rows; // random row index
-
-            Tile* tile = grid[y][x];
-            // check if the tile is not already a mine
-            if (dynamic_cast<Mine*>(tile) == nullptr) {
-                // convert the tile to a Mine and mark it as a mine
-                delete tile;
-                grid[y][x] = new Mine(sf::Vector2i(x, y));
-                addedMines++;
-            }
-        }
-    }
-
-    void assignSurroundingMines(Board &board) {
-        int rows = board.rows;
-        int cols = board.cols;
-
-        for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                Tile* currentTile = board.grid[i][j];
-                if (dynamic_cast<Mine*>(currentTile) == nullptr) {
-                    // iterate through adjacent tiles
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        for (int dy = -1; dy <= 1; ++dy) {
-                            // calculate neighboring tile coordinates
-                            int nx = j + dx;
-                            int ny = i + dy;
-                            // check if neighboring tile is within the board
-                            if (nx >= 0 && nx < cols && ny >= 0 && ny < rows) {
-                                // get the neighboring tile
-                                Tile* neighborTile = board.grid[ny][nx];
-                                // if the neighboring tile is a mine, increment the surrounding_mines count
-                                if (dynamic_cast<Mine*>(neighborTile) != nullptr) {
-                                    currentTile->surrounding_mines++;
-                                }
-                            }
-                        }
+        int total = tileCount();
+        numMines = min(numMines, total - placedMines);
+        if (numMines <= 0 || placedMines > 0) return;
+        for (int top = total - numMines; top < total; ++top) {
+            int cell = tileIndex(int(rng.below(uint32_t(top) + 1)));
+            if (cells[cell] & CELL_MINE) {
+                cell = tileIndex(top);
+            }
+            cells[cell] |= CELL_MINE;
+            placedMines++;
+            hiddenSafe--;
+        }
+    }
+
+    // the 3^Dims box around a tile is separable: summing each axis's three
+    // cells in turn takes Dims passes instead of 26 reads per tile, each one
+    // a streamed SIMD kernel. a tile only ever reads cells that share its
+    // coordinates on the axes already summed, so the partial sums left in
+    // the border shell never reach it. mines keep a count of zero
+    void assignSurroundingMines() {
+        size_t total = cells.size();
+        pmr::vector<unsigned char> scratch(total, 0, cells.get_allocator());
+        unsigned char *from = counts.data();
+        unsigned char *to = scratch.data();
+        for (size_t i = 0; i < total; ++i) {
+            from[i] = (cells[i] & CELL_MINE) >> 4;
+        }
+        for (int d = 0; d < Dims; ++d) {
+            sumAlongAxis(from, to, strides[d], total - strides[d], strides[d]);
+            swap(from, to);
+        }
+        for (size_t i = 0; i < total; ++i) {
+            counts[i] = (cells[i] & (CELL_MINE | CELL_BORDER)) ? 0 : from[i];
+        }
+    }
+
+    void setFlagged(int index, bool value) {
+        if (cells[index] & CELL_HIDDEN) {
+            cells[index] = value ? cells[index] | CELL_FLAGGED : cells[index] & ~CELL_FLAGGED;
+        }
+    }
+
+    void revealCell(int index) {
+        cells[index] &= ~CELL_HIDDEN;
+        revealedCount++;
+        if (!(cells[index] & CELL_MINE)) {
+            hiddenSafe--;
+        }
+    }
+
+    // opens the tile and, if no mine touches it, its whole opening with a
+    // depth-first flood over the neighbor offsets; the border shell is never
+    // openable, so no bounds checks. returns the cell indices opened
+    pmr::vector<int> reveal(int start, pmr::memory_resource *scratch = pmr::get_default_resource()) {
+        pmr::vector<int> revealed(scratch);
+        if (!isOpenable(cells[start])) {
+            return revealed;
+        }
+        revealCell(start);
+        revealed.push_back(start);
+        if ((cells[start] & CELL_MINE) || counts[start]) {
+            return revealed;
+        }
+
+        pmr::vector<int> blanks(1, start, scratch);
+        while (!blanks.empty()) {
+            int index = blanks.back();
+            blanks.pop_back();
+            for (int k = 0; k < neighborCount; ++k) {
+                int neighbor = index + neighborOffsets[k];
+                if (isOpenable(cells[neighbor])) {
+                    revealCell(neighbor);
+                    revealed.push_back(neighbor);
+                    if (!counts[neighbor]) {
+                        blanks.push_back(neighbor);
                     }
                 }
             }
         }
+        return revealed;
     }
 };
 
-void drawNumbers(sf::RenderWindow &window, Board &board, sf::Sprite num1, sf::Sprite num2, sf::Sprite num3, sf::Sprite num4, sf::Sprite num5, sf::Sprite num6, sf::Sprite num7, sf::Sprite num8, unsigned int num_cols, unsigned int num_rows) {
-    for (int i = 0; i < num_cols; i++) {
-        for (int j = 0; j < num_rows; j++) {
+typedef VolumeBoard<3> CubeBoard;
+
+// window position of tile (x, y); hex boards shift odd rows half a tile
+template <class BoardT>
+sf::Vector2f tilePosition(int x, int y) {
+    int shift = BoardT::CellTopology::hexRows && (y & 1) ? 16 : 0;
+    return sf::Vector2f(float(32 * x + shift), float(32 * y));
+}
+
+// the tile under window point (px, py), false when it's off the board
+template <class BoardT>
+bool tileUnder(const BoardT &board, int px, int py, int &x, int &y) {
+    if (px < 0 || py < 0) return false;
+    y = py / 32;
+    px -= BoardT::CellTopology::hexRows && (y & 1) ? 16 : 0;
+    x = px / 32;
+    return px >= 0 && x < board.colCount() && y < board.rowCount();
+}
+
+template <class BoardT>
+void drawNumbers(sf::RenderWindow &window, BoardT &board, sf::Sprite num1, sf::Sprite num2, sf::Sprite num3, sf::Sprite num4, sf::Sprite num5, sf::Sprite num6, sf::Sprite num7, sf::Sprite num8) {
+    for (int i = 0; i < board.colCount(); i++) {
+        for (int j = 0; j < board.rowCount(); j++) {
             // get the tile at position (i, j) from the board
-            Tile* tile = board.getTileAt(i, j);
+            typename BoardT::Tile tile = board.getTileAt(i, j);
 
             // set the position of the sprite based on the tile's position
-            sf::Vector2f position(float(32 * i), float(32 * j));
+            sf::Vector2f position = tilePosition<BoardT>(i, j);
             num1.setPosition(position);
             num2.setPosition(position);
             num3.setPosition(position);
@@ -170,8 +2196,8 @@ void drawNumbers(sf::RenderWindow &window, Board &board, sf::Sprite num1, sf::Sp
             num7.setPosition(position);
             num8.setPosition(position);
 
-            if (!tile->hidden) {
-                switch (tile->surrounding_mines) {
+            if (!tile.isHidden()) {
+                switch (tile.getSurroundingMines()) {
                     case 1:
                         window.draw(num1);
                         break;
@@ -204,19 +2230,22 @@ void drawNumbers(sf::RenderWindow &window, Board &board, sf::Sprite num1, sf::Sp
     }
 }
 
-void drawTiles(sf::RenderWindow &window, Board &board, sf::Sprite &hiddenSprite, sf::Sprite &revealedSprite, unsigned int num_cols, unsigned int num_rows) {
-    for (int i = 0; i < num_cols; i++) {
-        for (int j = 0; j < num_rows; j++) {
+// showAll draws every tile open without touching the board, for the end of a game
+template <class BoardT>
+void drawTiles(sf::RenderWindow &window, BoardT &board, sf::Sprite &hiddenSprite, sf::Sprite &revealedSprite,
+               bool showAll = false) {
+    for (int i = 0; i < board.colCount(); i++) {
+        for (int j = 0; j < board.rowCount(); j++) {
             // get the tile at position (i, j) from the board
-            Tile* tile = board.getTileAt(i, j);
+            typename BoardT::Tile tile = board.getTileAt(i, j);
 
             // set the position of the sprite based on the tile's position
-            sf::Vector2f position(float(32 * i), float(32 * j));
+            sf::Vector2f position = tilePosition<BoardT>(i, j);
             hiddenSprite.setPosition(position);
             revealedSprite.setPosition(position);
 
             // draw the hidden sprite if the tile is hidden, otherwise draw the revealed sprite
-            if (tile->isHidden()) {
+            if (tile.isHidden() && !showAll) {
                 window.draw(hiddenSprite);
             } else {
                 window.draw(revealedSprite);
@@ -225,26 +2254,6 @@ void drawTiles(sf::RenderWindow &window, Board &board, sf::Sprite &hiddenSprite,
     }
 }
 
-void replaceGrid(Board &board, int colCount, int rowCount) {
-    // create a new grid to replace the existing one
-    vector<vector<Tile*>> newGrid;
-
-    // populate the new grid with regular tiles
-    for (int i = 0; i < rowCount; ++i) {
-        vector<Tile*> newRow;
-        for (int j = 0; j < colCount; ++j) {
-            newRow.push_back(new Tile(sf::Vector2i(j, i))); // creating a regular tile
-        }
-        newGrid.push_back(newRow);
-    }
-
-    // replace the old grid with the new one
-    board.grid = newGrid;
-
-    // add mines again
-    board.addMines(board.mines);
-}
-
 void drawCounter(sf::RenderWindow &window, int number, sf::Sprite digitsSprite, unsigned int num_rows) {
     // calculate the position to start drawing the digits
     int startX = 33;
@@ -313,81 +2322,976 @@ void drawTimer(sf::RenderWindow& window, int minutes, int seconds, int rowCount,
     window.draw(digitsSprite);
 }
 
-void drawFlags(sf::RenderWindow &window, Board &board, sf::Sprite &flagSprite, unsigned int num_cols, unsigned int num_rows) {
-    for (int i = 0; i < num_cols; i++) {
-        for (int j = 0; j < num_rows; j++) {
-            Tile* tile = board.getTileAt(i, j);
+template <class BoardT>
+void drawFlags(sf::RenderWindow &window, BoardT &board, sf::Sprite &flagSprite) {
+    for (int i = 0; i < board.colCount(); i++) {
+        for (int j = 0; j < board.rowCount(); j++) {
+            typename BoardT::Tile tile = board.getTileAt(i, j);
+
+            flagSprite.setPosition(tilePosition<BoardT>(i, j));
+
+            if (tile.isFlagged() && tile.isHidden()) {
+                window.draw(flagSprite);
+            }
+        }
+    }
+}
+
+template <class BoardT>
+void drawMines(sf::RenderWindow &window, BoardT &board, sf::Sprite &mineSprite, bool showAll = false) {
+    const pmr::vector<int> &mineCells = board.mineList();
+    for (size_t i = 0; i < mineCells.size(); i++) {
+        int index = mineCells[i];
+        if ((board.cells[index] & CELL_HIDDEN) && !showAll) continue;
+
+        sf::Vector2i tile = board.position(index);
+        mineSprite.setPosition(tilePosition<BoardT>(tile.x, tile.y));
+        window.draw(mineSprite);
+    }
+}
+
+// draws one layer of a volume board: axes 0 and 1 across the window, the
+// other axes fixed at their values in at. same sprites as the flat board,
+// counts past 8 are written with two half-size counter digits
+template <int Dims>
+void drawVolumeSlice(sf::RenderWindow &window, VolumeBoard<Dims> &board, typename VolumeBoard<Dims>::Coords at,
+                     sf::Sprite &hiddenSprite, sf::Sprite &revealedSprite, sf::Sprite &flagSprite,
+                     sf::Sprite &mineSprite, sf::Sprite *numberSprites, sf::Sprite digitsSprite) {
+    digitsSprite.setScale(0.5f, 0.5f);
+    for (at[1] = 0; at[1] < board.size[1]; ++at[1]) {
+        for (at[0] = 0; at[0] < board.size[0]; ++at[0]) {
+            int index = board.index(at);
+            unsigned char state = board.cells[index];
+            float x = float(32 * at[0]);
+            float y = float(32 * at[1]);
+
+            sf::Sprite &tileSprite = (state & CELL_HIDDEN) ? hiddenSprite : revealedSprite;
+            tileSprite.setPosition(x, y);
+            window.draw(tileSprite);
+            if (state & CELL_HIDDEN) {
+                if (state & CELL_FLAGGED) {
+                    flagSprite.setPosition(x, y);
+                    window.draw(flagSprite);
+                }
+                continue;
+            }
+
+            int count = board.counts[index];
+            if (state & CELL_MINE) {
+                mineSprite.setPosition(x, y);
+                window.draw(mineSprite);
+            }
+            else if (count >= 1 && count <= 8) {
+                numberSprites[count - 1].setPosition(x, y);
+                window.draw(numberSprites[count - 1]);
+            }
+            else if (count > 8) {
+                digitsSprite.setTextureRect(sf::IntRect(21 * (count / 10), 0, 21, 32));
+                digitsSprite.setPosition(x + 5, y + 8);
+                window.draw(digitsSprite);
+                digitsSprite.setTextureRect(sf::IntRect(21 * (count % 10), 0, 21, 32));
+                digitsSprite.setPosition(x + 16, y + 8);
+                window.draw(digitsSprite);
+            }
+        }
+    }
+}
+
+// draws the cols x rows window of an unbounded board whose top left tile is
+// (left, top); showMines also draws the hidden mines in view, for a lost game
+void drawChunkedView(sf::RenderWindow &window, ChunkedBoard &board, int left, int top, int cols, int rows,
+                     sf::Sprite &hiddenSprite, sf::Sprite &revealedSprite, sf::Sprite &flagSprite,
+                     sf::Sprite &mineSprite, sf::Sprite *numberSprites, bool showMines) {
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            ChunkedBoard::Tile tile = board.getTileAt(left + x, top + y);
+            sf::Vector2f position(float(32 * x), float(32 * y));
+
+            sf::Sprite &tileSprite = tile.isHidden() && !(showMines && tile.isMine()) ? hiddenSprite : revealedSprite;
+            tileSprite.setPosition(position);
+            window.draw(tileSprite);
+            if (tile.isMine() && (showMines || !tile.isHidden())) {
+                mineSprite.setPosition(position);
+                window.draw(mineSprite);
+            }
+            else if (tile.isHidden()) {
+                if (tile.isFlagged()) {
+                    flagSprite.setPosition(position);
+                    window.draw(flagSprite);
+                }
+            }
+            else if (tile.getSurroundingMines() > 0) {
+                numberSprites[tile.getSurroundingMines() - 1].setPosition(position);
+                window.draw(numberSprites[tile.getSurroundingMines() - 1]);
+            }
+        }
+    }
+}
+
+// won once every safe tile has been revealed, read straight off the counters
+template <class BoardT>
+bool checkGameWon(BoardT &board) {
+    return board.hiddenSafe == 0;
+}
+
+// opens every hidden, unflagged member of an untouched opening: the same
+// tiles the fill would find, in time proportional to the opening
+template <class BoardT>
+pmr::vector<sf::Vector2i> revealOpening(BoardT &board, int opening, pmr::memory_resource *scratch) {
+    const int *member = &board.openingMembers[board.openingStart[opening]];
+    const int *end = &board.openingMembers[0] + board.openingStart[opening + 1];
+    pmr::vector<sf::Vector2i> revealed(scratch);
+    revealed.reserve(end - member);
+    for (; member != end; ++member) {
+        if (isOpenable(board.cells[*member])) {
+            board.revealCell(*member);
+            revealed.push_back(board.position(*member));
+        }
+    }
+    return revealed;
+}
+
+// depth-first flood from blank tiles that are already open, visiting the
+// neighbors of every blank tile it opens; appends what it opens to revealed
+template <class BoardT>
+void neighborFill(BoardT &board, pmr::vector<int> &blanks, pmr::vector<sf::Vector2i> &revealed) {
+    unsigned char *cells = board.cells.data();
+    while (!blanks.empty()) {
+        int index = blanks.back();
+        blanks.pop_back();
+        for (int k = 0; k < BoardT::neighborCount; ++k) {
+            int neighbor = board.neighbor(index, k);
+            if (isOpenable(cells[neighbor])) {
+                board.revealCell(neighbor);
+                revealed.push_back(board.position(neighbor));
+                if (isOpenableBlank(cells[neighbor] | CELL_HIDDEN)) {
+                    blanks.push_back(neighbor);
+                }
+            }
+        }
+    }
+}
+
+// scanline fill from hidden blank seeds: each seed grows into a full span of
+// blank tiles on its row, then only the start of each blank run in the rows
+// above and below is queued. on hex boards the span touches the next rows
+// from half a tile further left or right, read off the topology's step table
+// for the span's row parity. appends what it opens to revealed
+template <class BoardT>
+void scanlineFill(BoardT &board, pmr::vector<sf::Vector2i> &seeds, pmr::vector<sf::Vector2i> &revealed) {
+    unsigned char *cells = board.cells.data();
+    while (!seeds.empty()) {
+        sf::Vector2i seed = seeds.back();
+        seeds.pop_back();
+
+        // row points at column 0; row[-1] and row[cols] are border cells
+        int rowStart = board.index(0, seed.y);
+        unsigned char *row = &cells[rowStart];
+        // already opened as part of another span
+        if (!isOpenableBlank(row[seed.x])) continue;
+
+        // the border ring stops both scans, so no bounds checks
+        int left = seed.x;
+        int right = seed.x;
+        while (isOpenableBlank(row[left - 1])) left--;
+        while (isOpenableBlank(row[right + 1])) right++;
+
+        // open the span together with the numbered tiles at both ends
+        for (int i = left - 1; i <= right + 1; ++i) {
+            if (isOpenable(row[i])) {
+                board.revealCell(rowStart + i);
+                revealed.push_back(sf::Vector2i(i, seed.y));
+            }
+        }
+
+        // rows above the first and below the last are border too
+        for (int dy = -1; dy <= 1; dy += 2) {
+            int neighborStart = rowStart + dy * board.rowStride();
+            unsigned char *neighborRow = &cells[neighborStart];
+            // a tile has neighborCount / 2 - 1 neighbors in each other row,
+            // listed first for the row above and last for the row below
+            const int (*steps)[2] = BoardT::CellTopology::steps[seed.y & 1];
+            int side = BoardT::neighborCount / 2 - 1;
+            int first = dy < 0 ? 0 : BoardT::neighborCount - side;
+            int last = first + side - 1;
+            bool inRun = false;
+            for (int i = left + steps[first][0]; i <= right + steps[last][0]; ++i) {
+                if (isOpenableBlank(neighborRow[i])) {
+                    // blank runs are opened when their seed is popped
+                    if (!inRun) seeds.push_back(sf::Vector2i(i, seed.y + dy));
+                    inRun = true;
+                }
+                else {
+                    inRun = false;
+                    if (isOpenable(neighborRow[i])) {
+                        board.revealCell(neighborStart + i);
+                        revealed.push_back(sf::Vector2i(i, seed.y + dy));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// the fill for layouts without contiguous rows and for the torus, whose
+// rows run on past the border: the neighbor flood from the clicked tile
+template <class BoardT>
+pmr::vector<sf::Vector2i> revealTilesByNeighbors(BoardT &board, int x, int y, pmr::memory_resource *scratch) {
+    unsigned char *cells = board.cells.data();
+    pmr::vector<sf::Vector2i> revealed(scratch);
+
+    if (x < 0 || x >= board.cols || y < 0 || y >= board.rows || !isOpenable(cells[board.index(x, y)])) {
+        return revealed;
+    }
+
+    int start = board.index(x, y);
+    board.revealCell(start);
+    revealed.push_back(sf::Vector2i(x, y));
+    if (!isOpenableBlank(cells[start] | CELL_HIDDEN)) {
+        return revealed;
+    }
+
+    pmr::vector<int> blanks(1, start, scratch);
+    neighborFill(board, blanks, revealed);
+    return revealed;
+}
+
+// reveals the clicked tile and, if it has no surrounding mines, the whole
+// opening around it; returns every tile that was newly revealed, the result
+// and the fill's queue come from scratch
+template <class BoardT>
+pmr::vector<sf::Vector2i> revealTiles(BoardT &board, int x, int y,
+                                      pmr::memory_resource *scratch = pmr::get_default_resource()) {
+    // a deferred board places its mines around the first tile opened
+    if (board.minesPending && x >= 0 && x < board.cols && y >= 0 && y < board.rows &&
+        isOpenable(board.cells[board.index(x, y)])) {
+        board.placeMinesAround(x, y);
+    }
+    // a blank in an indexed opening opens the precomputed member list
+    if (x >= 0 && x < board.cols && y >= 0 && y < board.rows && isOpenable(board.cells[board.index(x, y)])) {
+        int opening = board.openingAt(board.index(x, y));
+        if (opening >= 0) {
+            return revealOpening(board, opening, scratch);
+        }
+    }
+    if (!BoardT::CellLayout::rowMajor || BoardT::CellTopology::wraps) {
+        return revealTilesByNeighbors(board, x, y, scratch);
+    }
+    unsigned char *cells = board.cells.data();
+    pmr::vector<sf::Vector2i> revealed(scratch);
+
+    if (x < 0 || x >= board.cols || y < 0 || y >= board.rows || !isOpenable(cells[board.index(x, y)])) {
+        return revealed;
+    }
+
+    // a numbered tile (or a mine) opens on its own
+    int start = board.index(x, y);
+    if (!isOpenableBlank(cells[start])) {
+        board.revealCell(start);
+        revealed.push_back(sf::Vector2i(x, y));
+        return revealed;
+    }
+
+    pmr::vector<sf::Vector2i> seeds(1, sf::Vector2i(x, y), scratch);
+    scanlineFill(board, seeds, revealed);
+    return revealed;
+}
+
+// opens a batch of tiles with one combined fill, for chords and other
+// multi-tile moves: numbered tiles and mines open on their own, blanks in an
+// indexed opening open its member list, and every other blank seeds the same
+// fill, so openings shared by several tiles are walked once. the counters
+// are live, so a single checkGameWon afterwards covers the whole batch
+template <class BoardT>
+pmr::vector<sf::Vector2i> revealMany(BoardT &board, const sf::Vector2i *tiles, size_t count,
+                                     pmr::memory_resource *scratch = pmr::get_default_resource()) {
+    unsigned char *cells = board.cells.data();
+    pmr::vector<sf::Vector2i> revealed(scratch);
+    pmr::vector<sf::Vector2i> seeds(scratch);
+    pmr::vector<int> blanks(scratch);
+    bool scanline = BoardT::CellLayout::rowMajor && !BoardT::CellTopology::wraps;
+
+    for (size_t i = 0; i < count; ++i) {
+        int x = tiles[i].x;
+        int y = tiles[i].y;
+        if (x < 0 || x >= board.cols || y < 0 || y >= board.rows) continue;
+        int index = board.index(x, y);
+        if (!isOpenable(cells[index])) continue;
+        if (board.minesPending) {
+            board.placeMinesAround(x, y);
+        }
+
+        if (!isOpenableBlank(cells[index])) {
+            board.revealCell(index);
+            revealed.push_back(tiles[i]);
+            continue;
+        }
+        int opening = board.openingAt(index);
+        if (opening >= 0) {
+            pmr::vector<sf::Vector2i> members = revealOpening(board, opening, scratch);
+            revealed.insert(revealed.end(), members.begin(), members.end());
+        }
+        else if (scanline) {
+            seeds.push_back(tiles[i]);
+        }
+        else {
+            board.revealCell(index);
+            revealed.push_back(tiles[i]);
+            blanks.push_back(index);
+        }
+    }
+
+    if (scanline) {
+        scanlineFill(board, seeds, revealed);
+    }
+    else {
+        neighborFill(board, blanks, revealed);
+    }
+    return revealed;
+}
+
+// chording: on an open number with as many flags around it as its count,
+// opens every other hidden neighbor in one revealMany batch. anything else
+// is left alone and nothing is returned
+template <class BoardT>
+pmr::vector<sf::Vector2i> chord(BoardT &board, int x, int y,
+                                pmr::memory_resource *scratch = pmr::get_default_resource()) {
+    if (x < 0 || x >= board.cols || y < 0 || y >= board.rows) {
+        return pmr::vector<sf::Vector2i>(scratch);
+    }
+    int index = board.index(x, y);
+    unsigned char state = board.cells[index];
+    sf::Vector2i targets[BoardT::neighborCount];
+    int targetCount = 0;
+    int flags = 0;
+    if (!(state & (CELL_HIDDEN | CELL_MINE)) && (state & CELL_COUNT)) {
+        for (int k = 0; k < BoardT::neighborCount; ++k) {
+            int neighbor = board.neighbor(index, k);
+            unsigned char around = board.cells[neighbor];
+            if ((around & (CELL_HIDDEN | CELL_FLAGGED)) == (CELL_HIDDEN | CELL_FLAGGED)) {
+                flags++;
+            }
+            else if (isOpenable(around)) {
+                targets[targetCount++] = board.position(neighbor);
+            }
+        }
+    }
+    if (flags != int(state & CELL_COUNT)) {
+        targetCount = 0;
+    }
+    return revealMany(board, targets, targetCount, scratch);
+}
+
+// one run of consecutive cell indices changed by a move
+struct CellRun {
+    int start;
+    int length;
+};
+
+// a move in the log: the state bit it changed, where its runs and cell
+// states are, and whether it opened a mine (the move that lost the game)
+struct MoveDelta {
+    unsigned char bits;
+    size_t firstRun;
+    size_t runCount;
+    size_t firstState;
+    bool opensMine;
+};
+
+// the state bits a move can change, the rest of a cell is fixed during play
+const unsigned char MOVE_BITS = CELL_HIDDEN | CELL_FLAGGED;
+
+// unlimited undo/redo. a move changes one state bit on a set of cells
+// (hidden for reveals and chords, flagged for flags), so the log keeps which
+// cells, sorted into runs of consecutive indices: a scanline cascade comes
+// down to a few runs per row. each cell also keeps its hidden and flagged
+// bits from before and after the move in one byte (before in the high
+// nibble, after in the low one), and undo and redo write those back rather
+// than flipping: cells changed outside the log, like the debug view's mines,
+// still come back to the logged state. either direction costs the same.
+// recording a move drops the moves that could still have been redone
+class MoveLog {
+public:
+    pmr::vector<CellRun> runs;
+    pmr::vector<unsigned char> states;
+    pmr::vector<MoveDelta> moves;
+    // moves currently applied, the ones after it can be redone
+    size_t applied;
+
+    MoveLog(pmr::memory_resource *resource = pmr::get_default_resource())
+        : runs(resource), states(resource), moves(resource), applied(0) {}
+
+    void clear() {
+        runs.clear();
+        states.clear();
+        moves.clear();
+        applied = 0;
+    }
+
+    // whether the last applied move opened a mine, so the game stands lost
+    bool lost() const {
+        return applied > 0 && moves[applied - 1].opensMine;
+    }
+
+    // logs the tiles a move just changed, bits being what it flipped on them
+    template <class BoardT>
+    void record(const BoardT &board, const sf::Vector2i *tiles, size_t count, unsigned char bits,
+                pmr::memory_resource *scratch = pmr::get_default_resource()) {
+        if (count == 0) return;
+        if (applied < moves.size()) {
+            runs.resize(moves[applied].firstRun);
+            states.resize(moves[applied].firstState);
+            moves.resize(applied);
+        }
+
+        pmr::vector<int> changed(scratch);
+        changed.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            changed.push_back(board.index(tiles[i].x, tiles[i].y));
+        }
+        sort(changed.begin(), changed.end());
+
+        MoveDelta move = {bits, runs.size(), 0, states.size(), false};
+        for (size_t i = 0; i < changed.size(); ++i) {
+            // the move just ran, so the cell is in its after state
+            unsigned char after = board.cells[changed[i]];
+            states.push_back(((after ^ bits) & MOVE_BITS) << 1 | (after & MOVE_BITS) >> 3);
+            move.opensMine = move.opensMine || (after & (CELL_MINE | CELL_HIDDEN)) == CELL_MINE;
+            if (move.runCount > 0 && runs.back().start + runs.back().length == changed[i]) {
+                runs.back().length++;
+                continue;
+            }
+            CellRun run = {changed[i], 1};
+            runs.push_back(run);
+            move.runCount++;
+        }
+        moves.push_back(move);
+        applied++;
+    }
+
+    // takes back the last applied move, null when there is none
+    template <class BoardT>
+    const MoveDelta *undo(BoardT &board) {
+        if (applied == 0) return nullptr;
+        const MoveDelta &move = moves[--applied];
+        restore(board, move, true);
+        return &move;
+    }
+
+    // plays the next undone move again, null when there is none
+    template <class BoardT>
+    const MoveDelta *redo(BoardT &board) {
+        if (applied == moves.size()) return nullptr;
+        const MoveDelta &move = moves[applied++];
+        restore(board, move, false);
+        return &move;
+    }
+
+private:
+    // writes the move's before (or after) bits straight into the cells and
+    // settles the counters per cell: every state in the log was reached by
+    // play, so the opening index still holds
+    template <class BoardT>
+    void restore(BoardT &board, const MoveDelta &move, bool before) {
+        size_t state = move.firstState;
+        for (size_t r = move.firstRun; r < move.firstRun + move.runCount; ++r) {
+            for (int i = runs[r].start; i < runs[r].start + runs[r].length; ++i, ++state) {
+                unsigned char bits = (before ? states[state] >> 1 : states[state] << 3) & MOVE_BITS;
+                board.countCell(board.cells[i], -1);
+                board.cells[i] = (board.cells[i] & ~MOVE_BITS) | bits;
+                board.countCell(board.cells[i], 1);
+            }
+        }
+    }
+};
+
+// deductions from what the player can see: revealed numbers, flags (taken
+// as mines) and the mine total, never a mine bit or a hidden tile's count.
+// each number next to hidden tiles says "exactly c mines among these", kept
+// as a bitset over the frontier tiles. one constraint settles its tiles when
+// c is 0 or all of them; two overlapping ones A and B settle B's own tiles as
+// mines and A's own tiles as safe when B needs as many more mines as it has
+// tiles of its own (with A inside B, equal counts make B's extra tiles safe
+// the same way). settled tiles drop out of every constraint and the passes
+// repeat until nothing new comes out. buffers are kept between calls
+class FrontierSolver {
+public:
+    // cell indices proven safe, and proven to be mines, by the last solve
+    pmr::vector<int> safeCells;
+    pmr::vector<int> mineCells;
+
+    FrontierSolver(pmr::memory_resource *resource = pmr::get_default_resource())
+        : safeCells(resource), mineCells(resource), words(0), frontier(resource), varOf(resource),
+          constraintVars(resource), constraintStart(resource), constraintMines(resource), masks(resource),
+          knownMines(resource), knownSafe(resource), byVar(resource), pairs(resource) {}
+
+    // false when nothing new could be proven
+    template <class BoardT>
+    bool solve(const BoardT &board) {
+        safeCells.clear();
+        mineCells.clear();
+        int total = board.cellCount();
+        varOf.assign(total, -1);
+        frontier.clear();
+        constraintVars.clear();
+        constraintStart.assign(1, 0);
+        constraintMines.clear();
+
+        // one constraint per revealed number with unflagged hidden neighbors
+        int flags = 0;
+        for (int i = 0; i < total; ++i) {
+            unsigned char state = board.cell(i);
+            if ((state & (CELL_HIDDEN | CELL_FLAGGED | CELL_BORDER)) == (CELL_HIDDEN | CELL_FLAGGED)) flags++;
+            if (state & (CELL_HIDDEN | CELL_MINE | CELL_BORDER)) continue;
+
+            int known = 0;
+            size_t first = constraintVars.size();
+            for (int k = 0; k < board.neighborCount; ++k) {
+                int neighbor = board.neighbor(i, k);
+                unsigned char around = board.cell(neighbor);
+                if (around & CELL_BORDER) continue;
+                if (!(around & CELL_HIDDEN)) {
+                    known += (around & CELL_MINE) ? 1 : 0;
+                }
+                else if (around & CELL_FLAGGED) {
+                    known++;
+                }
+                else {
+                    if (varOf[neighbor] < 0) {
+                        varOf[neighbor] = int(frontier.size());
+                        frontier.push_back(neighbor);
+                    }
+                    constraintVars.push_back(varOf[neighbor]);
+                }
+            }
+            int needed = int(state & CELL_COUNT) - known;
+            int unknown = int(constraintVars.size() - first);
+            // nothing to learn, or contradicted by a wrong flag
+            if (unknown == 0 || needed < 0 || needed > unknown) {
+                constraintVars.resize(first);
+                continue;
+            }
+            constraintStart.push_back(int(constraintVars.size()));
+            constraintMines.push_back(needed);
+        }
+
+        int count = int(constraintMines.size());
+        words = (int(frontier.size()) + 63) / 64;
+        masks.assign(size_t(count) * words, 0);
+        for (int c = 0; c < count; ++c) {
+            for (int v = constraintStart[c]; v < constraintStart[c + 1]; ++v) {
+                masks[size_t(c) * words + constraintVars[v] / 64] |= uint64_t(1) << (constraintVars[v] % 64);
+            }
+        }
+        knownMines.assign(words, 0);
+        knownSafe.assign(words, 0);
+
+        // pairs of constraints sharing a tile; a tile is in at most
+        // neighborCount constraints, so this stays linear in the frontier
+        byVar.assign(frontier.size(), pmr::vector<int>());
+        for (int c = 0; c < count; ++c) {
+            for (int v = constraintStart[c]; v < constraintStart[c + 1]; ++v) {
+                byVar[constraintVars[v]].push_back(c);
+            }
+        }
+        pairs.clear();
+        for (size_t v = 0; v < byVar.size(); ++v) {
+            for (size_t a = 0; a < byVar[v].size(); ++a) {
+                for (size_t b = a + 1; b < byVar[v].size(); ++b) {
+                    pairs.push_back(make_pair(byVar[v][a], byVar[v][b]));
+                }
+            }
+        }
+        sort(pairs.begin(), pairs.end());
+        pairs.erase(unique(pairs.begin(), pairs.end()), pairs.end());
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int c = 0; c < count; ++c) {
+                uint64_t *mask = &masks[size_t(c) * words];
+                int left = 0;
+                for (int w = 0; w < words; ++w) {
+                    constraintMines[c] -= popcount64(mask[w] & knownMines[w]);
+                    mask[w] &= ~(knownMines[w] | knownSafe[w]);
+                    left += popcount64(mask[w]);
+                }
+                if (left > 0 && constraintMines[c] == 0) {
+                    changed |= settle(mask, knownSafe);
+                }
+                else if (left > 0 && constraintMines[c] == left) {
+                    changed |= settle(mask, knownMines);
+                }
+            }
+            for (size_t p = 0; p < pairs.size(); ++p) {
+                changed |= settlePair(pairs[p].first, pairs[p].second);
+                changed |= settlePair(pairs[p].second, pairs[p].first);
+            }
+        }
+
+        for (size_t v = 0; v < frontier.size(); ++v) {
+            if (knownSafe[v / 64] >> (v % 64) & 1) safeCells.push_back(frontier[v]);
+            if (knownMines[v / 64] >> (v % 64) & 1) mineCells.push_back(frontier[v]);
+        }
+
+        // every mine accounted for: whatever is still hidden is safe
+        if (flags + int(mineCells.size()) == board.mines) {
+            for (int i = 0; i < total; ++i) {
+                if (isOpenable(board.cell(i)) && !(board.cell(i) & CELL_BORDER) &&
+                    (varOf[i] < 0 || !(knownMines[varOf[i] / 64] >> (varOf[i] % 64) & 1)) &&
+                    (varOf[i] < 0 || !(knownSafe[varOf[i] / 64] >> (varOf[i] % 64) & 1))) {
+                    safeCells.push_back(i);
+                }
+            }
+        }
+        return !safeCells.empty() || !mineCells.empty();
+    }
 
-            flagSprite.setPosition(float(32 * i), float(32 * j));
+private:
+    int words;
+    // frontier tile number -> cell index, and back (-1 off the frontier)
+    pmr::vector<int> frontier;
+    pmr::vector<int> varOf;
+    // constraint c covers constraintVars[constraintStart[c]] up to the next
+    // start and still needs constraintMines[c]; its bitset is at c * words
+    pmr::vector<int> constraintVars;
+    pmr::vector<int> constraintStart;
+    pmr::vector<int> constraintMines;
+    pmr::vector<uint64_t> masks;
+    pmr::vector<uint64_t> knownMines;
+    pmr::vector<uint64_t> knownSafe;
+    pmr::vector<pmr::vector<int>> byVar;
+    pmr::vector<pair<int, int>> pairs;
+
+    // adds the tiles of mask to known, true if any was new
+    bool settle(const uint64_t *mask, pmr::vector<uint64_t> &known) {
+        bool added = false;
+        for (int w = 0; w < words; ++w) {
+            added = added || (mask[w] & ~known[w]);
+            known[w] |= mask[w];
+        }
+        return added;
+    }
 
-            if (tile->isFlagged() && tile->isHidden()) {
-                window.draw(flagSprite);
-            }
+    // B's own tiles hold at least B - A mines; when that is all of them,
+    // they are mines and A's own tiles are safe. masks and counts are only
+    // reduced together, so a pair is always read as of the same pass
+    bool settlePair(int a, int b) {
+        const uint64_t *maskA = &masks[size_t(a) * words];
+        const uint64_t *maskB = &masks[size_t(b) * words];
+        int onlyB = 0;
+        for (int w = 0; w < words; ++w) {
+            onlyB += popcount64(maskB[w] & ~maskA[w]);
         }
+        if (constraintMines[b] - constraintMines[a] != onlyB) return false;
+
+        bool added = false;
+        for (int w = 0; w < words; ++w) {
+            uint64_t mines = maskB[w] & ~maskA[w];
+            uint64_t safe = maskA[w] & ~maskB[w];
+            added = added || (mines & ~knownMines[w]) || (safe & ~knownSafe[w]);
+            knownMines[w] |= mines;
+            knownSafe[w] |= safe;
+        }
+        return added;
     }
-}
+};
 
-void drawMines(sf::RenderWindow &window, Board &board, sf::Sprite &mineSprite, unsigned int num_cols, unsigned int num_rows) {
-    for (int i = 0; i < num_cols; i++) {
-        for (int j = 0; j < num_rows; j++) {
-            Tile* tile = board.getTileAt(i, j);
+// tile openers for solvableWithoutGuessing's two kinds of copy
+inline void openForSolver(BoardSnapshot &game, int x, int y) {
+    game.reveal(x, y);
+}
 
-            mineSprite.setPosition(float(32 * i), float(32 * j));
+template <class BoardT>
+void openForSolver(BoardT &game, int x, int y) {
+    revealTiles(game, x, y);
+}
 
-            if (dynamic_cast<Mine*>(tile) != nullptr && !tile->isHidden()) {
-                window.draw(mineSprite);
-            }
+// plays a copy of a board (or a snapshot) from tile (x, y), opening only
+// tiles the solver proves safe, until it is cleared or stuck
+template <class GameT>
+bool playByDeduction(GameT &game, int x, int y, FrontierSolver &solver) {
+    openForSolver(game, x, y);
+    while (game.hiddenSafe > 0 && solver.solve(game)) {
+        for (size_t i = 0; i < solver.mineCells.size(); ++i) {
+            game.setCell(solver.mineCells[i], game.cell(solver.mineCells[i]) | CELL_FLAGGED);
+        }
+        for (size_t i = 0; i < solver.safeCells.size(); ++i) {
+            sf::Vector2i tile = game.position(solver.safeCells[i]);
+            openForSolver(game, tile.x, tile.y);
         }
     }
+    return game.hiddenSafe == 0;
+}
+
+// the board can be forked as a snapshot: only the chunks the game opens
+// get copied
+template <class BoardT>
+bool solvableWithoutGuessing(const BoardT &board, int x, int y, FrontierSolver &solver, true_type) {
+    BoardSnapshot game(board);
+    return playByDeduction(game, x, y, solver);
 }
 
-bool checkGameWon(Board &board, unsigned int num_cols, unsigned int num_rows)  {
-    for (unsigned int y = 0; y < num_rows; ++y) {
-        for (unsigned int x = 0; x < num_cols; ++x) {
-            Tile* tile = board.getTileAt(x, y);
+// tiled and wrapping boards play a full copy
+template <class BoardT>
+bool solvableWithoutGuessing(const BoardT &board, int x, int y, FrontierSolver &solver, false_type) {
+    BoardT game = board;
+    return playByDeduction(game, x, y, solver);
+}
+
+// whether the board clears from tile (x, y) by deduction alone
+template <class BoardT>
+bool solvableWithoutGuessing(const BoardT &board, int x, int y, FrontierSolver &solver) {
+    return solvableWithoutGuessing(board, x, y, solver,
+                                   integral_constant<bool, BoardT::CellLayout::rowMajor && !BoardT::CellTopology::wraps>());
+}
 
-                if (tile->hidden) {
+// boards smaller than this are always filled on one thread
+const int PARALLEL_REVEAL_MIN_CELLS = 1 << 20;
+// the fill starts on one thread and hands off to the workers once it has
+// opened this share of the board: setting up the workers touches every
+// cell, so only an opening that is already large pays for it
+const int PARALLEL_REVEAL_HANDOFF_SHARE = 16;
+
+// work shared between the reveal workers: blank tiles whose neighbors still
+// need visiting, plus the bookkeeping to notice when every worker ran dry
+struct ParallelRevealState {
+    mutex lock;
+    condition_variable wake;
+    pmr::vector<int> pool;
+    int idle;
+    int threadCount;
+    bool done;
+    atomic<int> waiting;
+
+    ParallelRevealState(int threads, pmr::memory_resource *resource)
+        : pool(resource), idle(0), threadCount(threads), done(false), waiting(0) {}
+};
 
-                    return false;
+// each tile starts as claimable when it is hidden and unflagged; the worker
+// that wins the exchange is the only one that ever writes that tile's byte
+template <class BoardT>
+void revealWorker(BoardT &board, atomic<unsigned char> *claim, ParallelRevealState &state, pmr::vector<int> &revealed) {
+    unsigned char *cells = board.cells.data();
+    pmr::vector<int> local(revealed.get_allocator());
+
+    for (;;) {
+        while (!local.empty()) {
+            int index = local.back();
+            local.pop_back();
+
+            // border cells are never claimable, so no bounds checks
+            for (int k = 0; k < BoardT::neighborCount; ++k) {
+                int neighbor = board.neighbor(index, k);
+                // cheap read first so finished tiles don't bounce cache lines
+                if (claim[neighbor].load(memory_order_relaxed) && claim[neighbor].exchange(0)) {
+                    cells[neighbor] &= ~CELL_HIDDEN;
+                    revealed.push_back(neighbor);
+                    if (!(cells[neighbor] & (CELL_MINE | CELL_COUNT))) {
+                        local.push_back(neighbor);
+                    }
                 }
             }
-        }
 
-    return true;
-}
+            // hand half of our frontier to idle workers
+            if (local.size() > 1 && state.waiting.load(memory_order_relaxed) > 0) {
+                lock_guard<mutex> guard(state.lock);
+                size_t half = local.size() / 2;
+                state.pool.insert(state.pool.end(), local.end() - half, local.end());
+                local.resize(local.size() - half);
+                state.wake.notify_all();
+            }
+        }
 
-void revealTiles(Board &board, int x, int y) {
-    int numRows = board.rows;
-    int numCols = board.cols;
+        unique_lock<mutex> guard(state.lock);
+        state.idle++;
+        state.waiting++;
+        while (state.pool.empty() && !state.done) {
+            // nobody holds any work, the opening is complete
+            if (state.idle == state.threadCount) {
+                state.done = true;
+                state.wake.notify_all();
+                break;
+            }
+            state.wake.wait(guard);
+        }
+        state.waiting--;
+        if (state.done) return;
 
-    if (x >= 0 && x < numCols && y >= 0 && y < numRows) {
+        size_t take = max<size_t>(1, state.pool.size() / state.threadCount);
+        local.assign(state.pool.end() - take, state.pool.end());
+        state.pool.resize(state.pool.size() - take);
+        state.idle--;
+    }
+}
 
-        Tile* clickedTile = board.getTileAt(x, y);
+// same result as revealTiles, but a large opening is flooded breadth-first
+// by a pool of workers that share the frontier; small boards and small
+// openings stay serial
+template <class BoardT>
+pmr::vector<sf::Vector2i> revealTilesParallel(BoardT &board, int x, int y, unsigned int threadCount = 0,
+                                              pmr::memory_resource *scratch = pmr::get_default_resource()) {
+    // a deferred board places its mines around the first tile opened
+    if (board.minesPending && x >= 0 && x < board.cols && y >= 0 && y < board.rows &&
+        isOpenable(board.cells[board.index(x, y)])) {
+        board.placeMinesAround(x, y);
+    }
+    if (threadCount == 0) {
+        threadCount = thread::hardware_concurrency();
+    }
+    // indexed openings are already proportional to their size
+    if (threadCount < 2 || board.rows * board.cols < PARALLEL_REVEAL_MIN_CELLS ||
+        x < 0 || x >= board.cols || y < 0 || y >= board.rows || !isOpenableBlank(board.cells[board.index(x, y)]) ||
+        board.openingAt(board.index(x, y)) >= 0) {
+        return revealTiles(board, x, y, scratch);
+    }
 
-        if (clickedTile->isHidden() && !clickedTile->isFlagged()) {
-            //reveal clicked tile
-            clickedTile->setHidden(false);
+    unsigned char *cells = board.cells.data();
+    int total = int(board.cells.size());
+    int start = board.index(x, y);
+    board.revealCell(start);
+    pmr::vector<sf::Vector2i> revealed(scratch);
+    revealed.push_back(sf::Vector2i(x, y));
+
+    // most openings are small: fill serially and stop there if it runs dry
+    pmr::vector<int> frontier(scratch);
+    frontier.push_back(start);
+    size_t handoff = size_t(total / PARALLEL_REVEAL_HANDOFF_SHARE);
+    while (!frontier.empty() && revealed.size() < handoff) {
+        int index = frontier.back();
+        frontier.pop_back();
+        for (int k = 0; k < BoardT::neighborCount; ++k) {
+            int neighbor = board.neighbor(index, k);
+            if (isOpenable(cells[neighbor])) {
+                board.revealCell(neighbor);
+                revealed.push_back(board.position(neighbor));
+                if (!(cells[neighbor] & (CELL_MINE | CELL_COUNT))) {
+                    frontier.push_back(neighbor);
+                }
+            }
+        }
+    }
+    if (frontier.empty()) {
+        return revealed;
+    }
 
-            //recursively reveal the tiles neighbors
-            if (clickedTile->surrounding_mines == 0) {
-                // iterate through the adjacent tiles
-                for (int i = -1; i <= 1; ++i) {
-                    for (int j = -1; j <= 1; ++j) {
-                        // skip the current tile
-                        if (i == 0 && j == 0) continue;
+    // scratch is only ever used from one thread, the workers allocate from
+    // a synchronized pool on top of it
+    pmr::synchronized_pool_resource workerScratch(scratch);
+    size_t claimBytes = size_t(total) * sizeof(atomic<unsigned char>);
+    atomic<unsigned char> *claim =
+        static_cast<atomic<unsigned char> *>(scratch->allocate(claimBytes, alignof(atomic<unsigned char>)));
+    pmr::vector<thread> workers(scratch);
+
+    // mark the claimable tiles in parallel slices
+    int slice = (total + threadCount - 1) / threadCount;
+    for (unsigned int t = 0; t < threadCount; ++t) {
+        workers.push_back(thread([claim, cells, slice, total, t]() {
+            int end = min(total, int(t + 1) * slice);
+            for (int i = int(t) * slice; i < end; ++i) {
+                claim[i].store(isOpenable(cells[i]) ? 1 : 0, memory_order_relaxed);
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    workers.clear();
+
+    // the tiles opened so far are no longer claimable, the workers pick
+    // up the serial fill's frontier
+    ParallelRevealState state(threadCount, &workerScratch);
+    state.pool.assign(frontier.begin(), frontier.end());
+    pmr::vector<pmr::vector<int>> revealedByWorker(threadCount, &workerScratch);
+    for (unsigned int t = 0; t < threadCount; ++t) {
+        workers.push_back(thread(revealWorker<BoardT>, ref(board), claim, ref(state), ref(revealedByWorker[t])));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    scratch->deallocate(claim, claimBytes, alignof(atomic<unsigned char>));
+
+    for (size_t t = 0; t < revealedByWorker.size(); ++t) {
+        for (size_t i = 0; i < revealedByWorker[t].size(); ++i) {
+            int index = revealedByWorker[t][i];
+            // workers only flipped hidden bits, settle the counters here
+            board.countCell(cells[index] | CELL_HIDDEN, -1);
+            board.countCell(cells[index], 1);
+            revealed.push_back(board.position(index));
+        }
+    }
+    return revealed;
+}
 
-                        int newX = x + i;
-                        int newY = y + j;
+// difficulty of a generated board: 3BV is the fewest left clicks that clear
+// it, one per opening plus one per numbered tile outside every opening
+struct BoardMetrics {
+    int bbbv;
+    int openings;
+    int isolatedNumbers;
+    // set once a game is won
+    double bbbvPerSecond;
+
+    string toString() const {
+        char buffer[96];
+        snprintf(buffer, sizeof(buffer), "3BV %d (%d openings, %d isolated numbers)", bbbv, openings, isolatedNumbers);
+        return buffer;
+    }
+};
 
-                        revealTiles(board, newX, newY);
+// one pass over the cells; the opening count comes straight from the
+// opening index when the board has one, otherwise from a fill that marks
+// each region once
+template <class BoardT>
+BoardMetrics measureBoard(const BoardT &board, double seconds = 0) {
+    BoardMetrics metrics = {0, 0, 0, 0};
+    bool countOpenings = !board.openingsValid;
+    vector<bool> seen(countOpenings ? board.cells.size() : 0);
+    vector<int> blanks;
+
+    for (int i = 0; i < int(board.cells.size()); ++i) {
+        unsigned char state = board.cells[i];
+        if (state & (CELL_MINE | CELL_BORDER)) continue;
+
+        if (!(state & CELL_COUNT)) {
+            if (!countOpenings || seen[i]) continue;
+            metrics.openings++;
+            seen[i] = true;
+            blanks.push_back(i);
+            while (!blanks.empty()) {
+                int index = blanks.back();
+                blanks.pop_back();
+                for (int k = 0; k < BoardT::neighborCount; ++k) {
+                    int neighbor = board.neighbor(index, k);
+                    if (!seen[neighbor] && BoardT::isBlank(board.cells[neighbor])) {
+                        seen[neighbor] = true;
+                        blanks.push_back(neighbor);
                     }
                 }
             }
+            continue;
+        }
+
+        bool nextToBlank = false;
+        for (int k = 0; k < BoardT::neighborCount && !nextToBlank; ++k) {
+            nextToBlank = BoardT::isBlank(board.cells[board.neighbor(i, k)]);
+        }
+        if (!nextToBlank) {
+            metrics.isolatedNumbers++;
         }
     }
+
+    if (!countOpenings) {
+        metrics.openings = int(board.openingStart.size()) - 1;
+    }
+    metrics.bbbv = metrics.openings + metrics.isolatedNumbers;
+    if (seconds > 0) {
+        metrics.bbbvPerSecond = metrics.bbbv / seconds;
+    }
+    return metrics;
 }
 
-void createLeaderboardWindow(int num_cols, int num_rows, const vector<string>& names, const vector<string>& times) {
+void createLeaderboardWindow(int num_cols, int num_rows, const pmr::vector<pmr::string>& names, const pmr::vector<pmr::string>& times) {
     sf::RenderWindow leaderboard_window(sf::VideoMode(16 * num_cols, (num_rows * 16) + 50), "Leaderboard Window", sf::Style::Close);
 
     sf::Font font;
@@ -412,7 +3316,7 @@ void createLeaderboardWindow(int num_cols, int num_rows, const vector<string>& n
 
     // fill the vector
     for (size_t i = 0; i < names.size() && i < times.size(); ++i) {
-        leaderboardEntries.push_back({times[i], names[i]});
+        leaderboardEntries.push_back({string(times[i]), string(names[i])});
     }
 
     // sort the entries
@@ -441,30 +3345,56 @@ void createLeaderboardWindow(int num_cols, int num_rows, const vector<string>& n
     }
 }
 
-void revealAllMines(Board &board, int colCount, int rowCount) {
-    for (int i = 0; i < colCount; ++i) {
-        for (int j = 0; j < rowCount; ++j) {
-            Tile* tile = board.getTileAt(i, j);
-            if (Mine* mine = dynamic_cast<Mine*>(tile)) {
-                mine->setHidden(false);
-            }
-        }
+// both walk the board's mine index instead of every tile
+template <class BoardT>
+void revealAllMines(BoardT &board) {
+    const pmr::vector<int> &mineCells = board.mineList();
+    for (size_t i = 0; i < mineCells.size(); ++i) {
+        int index = mineCells[i];
+        board.setCell(index, board.cells[index] & ~CELL_HIDDEN);
     }
 }
 
-void hideAllMines(Board &board, int colCount, int rowCount) {
-    for (int i = 0; i < colCount; ++i) {
-        for (int j = 0; j < rowCount; ++j) {
-            Tile* tile = board.getTileAt(i, j);
-            if (dynamic_cast<Mine*>(tile) != nullptr) {
-                tile->setHidden(true);
-            }
+// the mines revealAllMines is about to open, so a losing move can log them
+template <class BoardT>
+void appendHiddenMines(BoardT &board, pmr::vector<sf::Vector2i> &tiles) {
+    const pmr::vector<int> &mineCells = board.mineList();
+    for (size_t i = 0; i < mineCells.size(); ++i) {
+        if (board.cells[mineCells[i]] & CELL_HIDDEN) {
+            tiles.push_back(board.position(mineCells[i]));
         }
     }
 }
 
-void createGameWindow(int colCount, int rowCount, string name) {
-    sf::RenderWindow game_window(sf::VideoMode((colCount * 32), (rowCount * 32 + 100)), "Game Window", sf::Style::Close);
+template <class BoardT>
+void hideAllMines(BoardT &board) {
+    const pmr::vector<int> &mineCells = board.mineList();
+    for (size_t i = 0; i < mineCells.size(); ++i) {
+        int index = mineCells[i];
+        board.setCell(index, board.cells[index] | CELL_HIDDEN);
+    }
+}
+
+// appends a win to the leaderboard, stats go after the name (may be empty)
+bool recordWin(int minutes, int seconds, const string &name, const char *stats) {
+    ofstream leaderboardFile("leaderboard.txt", ios::app); // Open the file in append mode
+    if (!leaderboardFile.is_open()) {
+        cerr << "error" << endl;
+        return false;
+    }
+    if (minutes == 0) {
+        leaderboardFile << "*00:" << (seconds < 10 ? "0" : "") << seconds << ", " << name << stats << endl;
+    } else {
+        leaderboardFile << "*" << minutes << ":" << (seconds < 10 ? "0" : "") << seconds << ", " << name << stats << endl;
+    }
+    return true;
+}
+
+template <class BoardT>
+void playGame(int colCount, int rowCount, string name) {
+    // hex rows stick out half a tile on the right
+    int boardWidth = colCount * 32 + (BoardT::CellTopology::hexRows ? 16 : 0);
+    sf::RenderWindow game_window(sf::VideoMode(boardWidth, (rowCount * 32 + 100)), "Game Window", sf::Style::Close);
 
     //read config for mines
     string line;
@@ -477,29 +3407,74 @@ void createGameWindow(int colCount, int rowCount, string name) {
     getline(config, line);
     int mineCount = stoi(line);
 
+    // an optional fourth line replays a board id of the same size and shape
+    uint64_t seed = randomSeed();
+    BoardId replay;
+    bool replaying = getline(config, line) && BoardId::parse(line, replay);
+    if (replaying && (replay.cols != colCount || replay.rows != rowCount || replay.topology != BoardT::CellTopology::idSuffix)) {
+        cerr << "board " << line << " doesn't fit this board's size or topology, playing a new one" << endl;
+        replaying = false;
+    }
+    if (replaying) {
+        mineCount = replay.mines;
+        seed = replay.seed;
+    }
+
+    // the board and everything kept for this window come from one arena,
+    // sized for the board plus the usual per-game scratch
+    size_t cellBytes = size_t(colCount + 2) * (rowCount + 2);
+    GameArena arena(2 * cellBytes + mineCount * sizeof(int) + 16384, 16 * cellBytes + 16384);
+
     //leaderboard
     ifstream leaderboard_file("leaderboard.txt");
     if (!leaderboard_file.is_open()) {
         cerr << "Error opening file!" << endl;
     }
-    vector<string> times;
-    vector<string> names;
+    pmr::vector<pmr::string> times(&arena.session);
+    pmr::vector<pmr::string> names(&arena.session);
 
-    string temp;
+    pmr::string temp(&arena.session);
     while (getline(leaderboard_file, temp, ',')) {
         times.push_back(temp);
         getline(leaderboard_file, temp);
-        names.push_back(temp);
+        // newer entries carry the board's metrics after the name
+        names.push_back(temp.substr(0, temp.find(',')));
     }
 
     //game state & board
-    Board board(rowCount, colCount, mineCount);
-    board.assignSurroundingMines(board);
+    // mines go down on the first click, away from it, so the window opens
+    // without generating anything and the first click is always safe.
+    // a replayed id without a first click ("COLSxROWSxMINES-SEED") was
+    // generated up front, so it is rebuilt that way
+    BoardT board(rowCount, colCount, mineCount, seed, &arena.session,
+                 replaying && replay.safeX < 0 ? PLACE_MINES_NOW : PLACE_MINES_ON_FIRST_REVEAL);
+    if (replaying) {
+        if (replay.safeX >= 0) {
+            board.placeMinesAround(replay.safeX, replay.safeY);
+        }
+        else {
+            board.assignSurroundingMines(board);
+        }
+        cout << "board " << board.getId().toString() << " " << measureBoard(board).toString() << endl;
+    }
+    arena.report("at start");
     bool gameOver = false;
     bool debugMode = false;
     bool isPaused = false;
     bool gameWon = false;
     bool scoreRecorded = false;
+    BoardMetrics metrics = measureBoard(board);
+    // editor mode (E): the board lies open and clicking or dragging paints
+    // mines on or off, leaving it restarts play on the edited board
+    bool editorMode = false;
+    bool painting = false;
+    bool paintMines = false;
+    // every reveal, chord and flag, for undo (ctrl+z) and redo (ctrl+y)
+    MoveLog history(&arena.game);
+    // H marks one tile the visible numbers decide, A plays every move
+    // they prove until a guess is needed
+    FrontierSolver solver(&arena.game);
+    int hintIndex = -1;
     int minesRemaining = board.mines;
     sf::Clock clock;
     sf::Time totalTime;
@@ -651,29 +3626,170 @@ void createGameWindow(int colCount, int rowCount, string name) {
                 case sf::Event::Closed:
                     game_window.close();
                 break;
+                case sf::Event::KeyPressed:
+                    hintIndex = -1;
+                    // a finished game pauses itself, its last move can still be taken back
+                    if (event.key.control && (event.key.code == sf::Keyboard::Z || event.key.code == sf::Keyboard::Y) &&
+                        !editorMode && (!isPaused || gameOver || gameWon)) {
+                        bool finished = gameOver || gameWon;
+                        const MoveDelta *move = event.key.code == sf::Keyboard::Z ? history.undo(board) : history.redo(board);
+                        if (move && move->bits == CELL_FLAGGED) {
+                            int index = history.runs[move->firstRun].start;
+                            minesRemaining += (board.cells[index] & CELL_FLAGGED) ? -1 : 1;
+                        }
+                        // the log knows which move opened a mine, the debug view's mines don't count
+                        gameOver = history.lost();
+                        gameWon = !gameOver && checkGameWon(board);
+                        if (finished && !gameOver && !gameWon) {
+                            isPaused = false;
+                            clock.restart();
+                        }
+                    }
+                    else if (event.key.code == sf::Keyboard::E) {
+                        editorMode = !editorMode;
+                        painting = false;
+                        history.clear();
+                        // a finished game paused itself, the editor and the
+                        // edited board start fresh
+                        gameOver = false;
+                        gameWon = false;
+                        isPaused = false;
+                        if (editorMode) {
+                            board.minesPending = false;
+                            board.revealAllTiles();
+                        }
+                        else {
+                            board.restartSameBoard();
+                            metrics = measureBoard(board);
+                            cout << "edited board " << metrics.toString() << endl;
+                            minesRemaining = board.mines;
+                            clock.restart();
+                            totalTime = sf::Time::Zero;
+                        }
+                    }
+                    else if (event.key.code == sf::Keyboard::H && !editorMode && !isPaused && !board.minesPending) {
+                        if (solver.solve(board)) {
+                            hintIndex = solver.safeCells.empty() ? solver.mineCells[0] : solver.safeCells[0];
+                            sf::Vector2i hint = board.position(hintIndex);
+                            cout << "hint: " << (solver.safeCells.empty() ? "mine" : "safe") << " at " << hint.x << "," << hint.y << endl;
+                        }
+                        else {
+                            cout << "hint: nothing is certain, a guess is needed" << endl;
+                        }
+                    }
+                    else if (event.key.code == sf::Keyboard::A && !editorMode && !isPaused && !board.minesPending) {
+                        // flags count as mines, so a wrong flag can lead the solver
+                        // onto a mine: that ends the game like any losing move
+                        while (!gameWon && !gameOver && solver.solve(board)) {
+                            for (size_t i = 0; i < solver.mineCells.size(); ++i) {
+                                sf::Vector2i flagged = board.position(solver.mineCells[i]);
+                                board.getTileAt(flagged.x, flagged.y).setFlagged(true);
+                                minesRemaining--;
+                                history.record(board, &flagged, 1, CELL_FLAGGED, &arena.game);
+                            }
+                            pmr::vector<sf::Vector2i> safe(&arena.game);
+                            for (size_t i = 0; i < solver.safeCells.size(); ++i) {
+                                safe.push_back(board.position(solver.safeCells[i]));
+                            }
+                            pmr::vector<sf::Vector2i> opened = revealMany(board, safe.data(), safe.size(), &arena.game);
+                            for (size_t i = 0; i < opened.size(); ++i) {
+                                if (board.getTileAt(opened[i].x, opened[i].y).isMine()) {
+                                    gameOver = true;
+                                }
+                            }
+                            if (gameOver) {
+                                appendHiddenMines(board, opened);
+                                revealAllMines(board);
+                            }
+                            history.record(board, opened.data(), opened.size(), CELL_HIDDEN, &arena.game);
+                            gameWon = !gameOver && checkGameWon(board);
+                        }
+                    }
+                break;
+                case sf::Event::MouseButtonReleased:
+                    painting = false;
+                break;
+                case sf::Event::MouseMoved:
+                    if (painting) {
+                        int gridX, gridY;
+                        if (tileUnder(board, event.mouseMove.x, event.mouseMove.y, gridX, gridY)) {
+                            board.setMine(board.index(gridX, gridY), paintMines);
+                        }
+                    }
+                break;
                 case sf::Event::MouseButtonPressed:
-                    if (event.mouseButton.button == sf::Mouse::Left) {
+                    hintIndex = -1;
+                    // chord: middle click, or both buttons together, on an open number
+                    if (!isPaused && !editorMode && !gameOver &&
+                        (event.mouseButton.button == sf::Mouse::Middle ||
+                         (event.mouseButton.button == sf::Mouse::Left && sf::Mouse::isButtonPressed(sf::Mouse::Right)) ||
+                         (event.mouseButton.button == sf::Mouse::Right && sf::Mouse::isButtonPressed(sf::Mouse::Left)))) {
+                        sf::Vector2i mousePos = sf::Mouse::getPosition(game_window);
+                        int gridX, gridY;
+                        if (tileUnder(board, mousePos.x, mousePos.y, gridX, gridY)) {
+                            pmr::vector<sf::Vector2i> opened = chord(board, gridX, gridY, &arena.game);
+                            for (size_t i = 0; i < opened.size(); ++i) {
+                                if (board.getTileAt(opened[i].x, opened[i].y).isMine()) {
+                                    gameOver = true;
+                                }
+                            }
+                            if (gameOver) {
+                                appendHiddenMines(board, opened);
+                                revealAllMines(board);
+                            }
+                            history.record(board, opened.data(), opened.size(), CELL_HIDDEN, &arena.game);
+                            gameWon = !gameOver && checkGameWon(board);
+                        }
+                        break;
+                    }
+                    if (event.mouseButton.button == sf::Mouse::Left && editorMode) {
+                        sf::Vector2i mousePos = sf::Mouse::getPosition(game_window);
+                        int gridX, gridY;
+                        if (tileUnder(board, mousePos.x, mousePos.y, gridX, gridY)) {
+                            // the first tile decides whether this stroke adds or removes mines
+                            int index = board.index(gridX, gridY);
+                            paintMines = !(board.cells[index] & CELL_MINE);
+                            board.setMine(index, paintMines);
+                            painting = true;
+                        }
+                    }
+                    else if (event.mouseButton.button == sf::Mouse::Left) {
                         if (!isPaused) {
                             // mouse pos
                             sf::Vector2i mousePos = sf::Mouse::getPosition(game_window);
 
 
-                            if (mousePos.x >= 0 && mousePos.x < colCount * 32 &&
-                                mousePos.y >= 0 && mousePos.y < rowCount * 32) {
-                                //grid position from mousepos
-                                int gridX = mousePos.x / 32;
-                                int gridY = mousePos.y / 32;
+                            //grid position from mousepos
+                            int gridX, gridY;
+                            if (tileUnder(board, mousePos.x, mousePos.y, gridX, gridY)) {
 
-                                Tile* tile = board.getTileAt(gridX, gridY);
+                                typename BoardT::Tile tile = board.getTileAt(gridX, gridY);
 
                                 //check if hidden
-                                if (tile->isHidden()) {
-                                    if (Mine* mine = dynamic_cast<Mine*>(tile)) {
+                                if (tile.isHidden()) {
+                                    if (board.minesPending && !tile.isFlagged()) {
+                                        board.placeMinesAround(gridX, gridY);
+                                        metrics = measureBoard(board);
+                                        cout << "board " << board.getId().toString() << " " << metrics.toString() << endl;
+                                        // one solver pass per move is cheap, replaying the whole
+                                        // game runs on the click: up to 64x64 it stays within a frame
+                                        if (size_t(board.rows) * board.cols <= 4096) {
+                                            cout << "solvable without guessing: "
+                                                 << (solvableWithoutGuessing(board, gridX, gridY, solver) ? "yes" : "no") << endl;
+                                        }
+                                        if (debugMode) {
+                                            revealAllMines(board);
+                                        }
+                                    }
+                                    pmr::vector<sf::Vector2i> opened = revealTilesParallel(board, gridX, gridY, 0, &arena.game);
+                                    if (tile.isMine()) {
                                         gameOver = true;
-                                        revealAllMines(board, colCount, rowCount);
+                                        // the other mines open as part of the losing move
+                                        appendHiddenMines(board, opened);
+                                        revealAllMines(board);
                                     }
-                                    revealTiles(board, gridX, gridY);
-                                    gameWon = checkGameWon(board, colCount, rowCount);
+                                    history.record(board, opened.data(), opened.size(), CELL_HIDDEN, &arena.game);
+                                    gameWon = checkGameWon(board);
                                 }
                                 }
                         }
@@ -686,21 +3802,31 @@ void createGameWindow(int colCount, int rowCount, string name) {
                     if (debugBounds.contains(sf::Vector2f(mousePos))) {
                         debugMode = !debugMode;
                         if(debugMode) {
-                            revealAllMines(board, colCount, rowCount);
+                            revealAllMines(board);
                         }
                         else {
-                            hideAllMines(board, colCount, rowCount);
+                            hideAllMines(board);
                         }
 
                     }
                     sf::FloatRect faceBounds = face_happy_sprite.getGlobalBounds();
                     if (faceBounds.contains(sf::Vector2f(mousePos))) {
 
-                        replaceGrid(board, colCount, rowCount);
+                        arena.report("before restart");
+                        // both keep their buffers in the game arena, so they
+                        // let go of them before it is released
+                        history = MoveLog(&arena.game);
+                        solver = FrontierSolver(&arena.game);
+                        // only the replayed board itself is generated up front,
+                        // and new boards go back to the configured mine count
+                        // rather than whatever the editor left
+                        board.placement = PLACE_MINES_ON_FIRST_REVEAL;
+                        board.mines = mineCount;
+                        board.reset();
+                        arena.restart();
+                        arena.report("after restart");
                         gameOver = false;
                         gameWon = false;
-                        board.addMines(board.mines);
-                        board.assignSurroundingMines(board);
                         minesRemaining = board.mines;
                         clock.restart();
                         isPaused = false;
@@ -721,24 +3847,24 @@ void createGameWindow(int colCount, int rowCount, string name) {
 
                     sf::Vector2i mousePos = sf::Mouse::getPosition(game_window);
 
-                    if (mousePos.x >= 0 && mousePos.x < colCount * 32 && mousePos.y >= 0 && mousePos.y < rowCount * 32) {
+                    int gridX, gridY;
+                    if (tileUnder(board, mousePos.x, mousePos.y, gridX, gridY)) {
 
-                        int gridX = mousePos.x / 32;
-                        int gridY = mousePos.y / 32;
+                        typename BoardT::Tile tile = board.getTileAt(gridX, gridY);
 
-                        Tile* tile = board.getTileAt(gridX, gridY);
-
-                        if (tile->isHidden()) {
+                        if (tile.isHidden()) {
                             // remove flag
-                            if (tile->isFlagged()) {
-                                tile->setFlagged(false);
+                            if (tile.isFlagged()) {
+                                tile.setFlagged(false);
                                 minesRemaining++;
                             }
                             else {
                                 // set flag
-                                tile->setFlagged(true);
+                                tile.setFlagged(true);
                                 minesRemaining--;
                             }
+                            sf::Vector2i flagged(gridX, gridY);
+                            history.record(board, &flagged, 1, CELL_FLAGGED, &arena.game);
                         }
                         }
                 }
@@ -748,7 +3874,7 @@ void createGameWindow(int colCount, int rowCount, string name) {
 
         // calculate time
         sf::Time elapsedTime = clock.getElapsedTime();
-        if (!isPaused)
+        if (!isPaused && !editorMode)
             totalTime += elapsedTime;
 
         clock.restart();
@@ -757,12 +3883,22 @@ void createGameWindow(int colCount, int rowCount, string name) {
         minutes = totalSeconds / 60;
         seconds = totalSeconds % 60;
 
+        // a finished game is drawn fully open, the cells keep their state so
+        // the last move can still be undone
+        bool finished = gameOver || gameWon;
         game_window.clear(sf::Color::White);
-        drawTiles(game_window, board, hidden_tile_sprite, revealed_tile_sprite, colCount, rowCount);
-        drawMines(game_window, board, mine_sprite, colCount, rowCount);
+        drawTiles(game_window, board, hidden_tile_sprite, revealed_tile_sprite, finished);
+        if (hintIndex >= 0) {
+            sf::Vector2i hint = board.position(hintIndex);
+            revealed_tile_sprite.setPosition(tilePosition<BoardT>(hint.x, hint.y));
+            revealed_tile_sprite.setColor(sf::Color(255, 255, 255, 128));
+            game_window.draw(revealed_tile_sprite);
+            revealed_tile_sprite.setColor(sf::Color::White);
+        }
+        drawMines(game_window, board, mine_sprite, finished);
         if(!isPaused) {
-            drawNumbers(game_window, board, number1_sprite, number2_sprite, number3_sprite, number4_sprite, number5_sprite, number6_sprite, number7_sprite, number8_sprite, colCount, rowCount);
-            drawFlags(game_window, board, flag_sprite, colCount, rowCount);
+            drawNumbers(game_window, board, number1_sprite, number2_sprite, number3_sprite, number4_sprite, number5_sprite, number6_sprite, number7_sprite, number8_sprite);
+            drawFlags(game_window, board, flag_sprite);
         }
 
 
@@ -770,12 +3906,10 @@ void createGameWindow(int colCount, int rowCount, string name) {
         drawTimer(game_window, minutes, seconds, rowCount, colCount, digits_texture, digits_sprite);
         game_window.draw(pause_sprite);
         if(gameOver) {
-            board.revealAllTiles();
             game_window.draw(face_lose_sprite);
             isPaused = true;
         }
         else if (gameWon){
-            board.revealAllTiles();
             game_window.draw(face_win_sprite);
             isPaused = true;
 
@@ -789,22 +3923,336 @@ void createGameWindow(int colCount, int rowCount, string name) {
         game_window.display();
 
         if (gameWon && !scoreRecorded) {
-            //write to file
-            ofstream leaderboardFile("leaderboard.txt", ios::app); // Open the file in append mode
-            if (leaderboardFile.is_open()) {
-                if (minutes == 0) {
-                    leaderboardFile << "*00:" << (seconds < 10 ? "0" : "") << seconds << ", " << name << endl;
-                } else {
-                    leaderboardFile << "*" << minutes << ":" << (seconds < 10 ? "0" : "") << seconds << ", " << name << endl;
+            metrics = measureBoard(board, totalTime.asSeconds());
+            char stats[64];
+            snprintf(stats, sizeof(stats), ", %d, %d, %d, %.2f", metrics.bbbv, metrics.openings, metrics.isolatedNumbers,
+                     metrics.bbbvPerSecond);
+
+            //write to file: time, name, 3BV, openings, isolated numbers, 3BV/s
+            scoreRecorded = recordWin(minutes, seconds, name, stats);
+        }
+    }
+}
+
+// layered 3D game: the window shows one layer of a cols x rows x layers
+// cube at a time, up/down (or page up/page down) move between layers
+void playVolumeGame(int colCount, int rowCount, int layerCount, string name) {
+    sf::RenderWindow game_window(sf::VideoMode((colCount * 32), (rowCount * 32 + 100)), "Game Window", sf::Style::Close);
+
+    //read config for mines
+    string line;
+    ifstream config("config.cfg");
+    getline(config, line);
+    getline(config, line);
+    getline(config, line);
+    int mineCount = stoi(line);
+
+    // the configured density on every layer, mines placed on the first click
+    CubeBoard::Coords size = {colCount, rowCount, layerCount};
+    CubeBoard board(size, mineCount * layerCount, randomSeed(), pmr::get_default_resource(), PLACE_MINES_ON_FIRST_REVEAL);
+    CubeBoard::Coords at = {0, 0, 0};
+    bool gameOver = false;
+    bool gameWon = false;
+    bool scoreRecorded = false;
+    int flags = 0;
+    sf::Clock clock;
+    sf::Time totalTime;
+
+    //sprites and textures
+    sf::Texture hidden_tile, revealed_texture, flag_texture, mine_texture, digits_texture;
+    sf::Texture face_happy_texture, face_win_texture, face_lose_texture;
+    if (!hidden_tile.loadFromFile("images/tile_hidden.png") || !revealed_texture.loadFromFile("images/tile_revealed.png") ||
+        !flag_texture.loadFromFile("images/flag.png") || !mine_texture.loadFromFile("images/mine.png") ||
+        !digits_texture.loadFromFile("images/digits.png") || !face_happy_texture.loadFromFile("images/face_happy.png") ||
+        !face_win_texture.loadFromFile("images/face_win.png") || !face_lose_texture.loadFromFile("images/face_lose.png")) {
+        cout << "error" << endl;
+    }
+    sf::Sprite hidden_tile_sprite(hidden_tile);
+    sf::Sprite revealed_tile_sprite(revealed_texture);
+    sf::Sprite flag_sprite(flag_texture);
+    sf::Sprite mine_sprite(mine_texture);
+    sf::Sprite digits_sprite(digits_texture);
+    sf::Sprite face_sprites[3] = {sf::Sprite(face_happy_texture), sf::Sprite(face_win_texture), sf::Sprite(face_lose_texture)};
+    for (int f = 0; f < 3; ++f) {
+        face_sprites[f].setPosition((colCount/2)*32 - 32, 32 * (rowCount + 0.5));
+    }
+    sf::Texture number_textures[8];
+    sf::Sprite number_sprites[8];
+    for (int n = 0; n < 8; ++n) {
+        if (!number_textures[n].loadFromFile("images/number_" + to_string(n + 1) + ".png")) {
+            cout << "error" << endl;
+        }
+        number_sprites[n].setTexture(number_textures[n]);
+    }
+
+    while (game_window.isOpen()) {
+        sf::Event event;
+        while (game_window.pollEvent(event)) {
+            switch (event.type) {
+                case sf::Event::Closed:
+                    game_window.close();
+                break;
+                case sf::Event::KeyPressed:
+                    if (event.key.code == sf::Keyboard::Up || event.key.code == sf::Keyboard::PageUp) {
+                        at[2] = min(at[2] + 1, layerCount - 1);
+                    }
+                    else if (event.key.code == sf::Keyboard::Down || event.key.code == sf::Keyboard::PageDown) {
+                        at[2] = max(at[2] - 1, 0);
+                    }
+                break;
+                case sf::Event::MouseButtonPressed: {
+                    sf::Vector2i mousePos = sf::Mouse::getPosition(game_window);
+                    if (gameOver || gameWon || mousePos.x < 0 || mousePos.x >= colCount * 32 || mousePos.y < 0 || mousePos.y >= rowCount * 32) {
+                        break;
+                    }
+                    at[0] = mousePos.x / 32;
+                    at[1] = mousePos.y / 32;
+                    int index = board.index(at);
+                    if (event.mouseButton.button == sf::Mouse::Left && isOpenable(board.cells[index])) {
+                        board.placeMinesAround(at);
+                        board.reveal(index);
+                        gameOver = (board.cells[index] & CELL_MINE) != 0;
+                        gameWon = !gameOver && board.hiddenSafe == 0;
+                        // a lost game shows the mines on every layer
+                        if (gameOver) {
+                            for (size_t i = 0; i < board.cells.size(); ++i) {
+                                if (board.cells[i] & CELL_MINE) board.cells[i] &= ~CELL_HIDDEN;
+                            }
+                        }
+                    }
+                    else if (event.mouseButton.button == sf::Mouse::Right && (board.cells[index] & CELL_HIDDEN)) {
+                        bool flagged = board.cells[index] & CELL_FLAGGED;
+                        board.setFlagged(index, !flagged);
+                        flags += flagged ? -1 : 1;
+                    }
+                }
+                break;
+            }
+        }
+
+        // the clock stops once the game is decided
+        if (!gameOver && !gameWon) {
+            totalTime += clock.getElapsedTime();
+        }
+        clock.restart();
+        int totalSeconds = totalTime.asSeconds();
+
+        game_window.setTitle("Game Window - layer " + to_string(at[2] + 1) + " of " + to_string(layerCount));
+        game_window.clear(sf::Color::White);
+        drawVolumeSlice(game_window, board, at, hidden_tile_sprite, revealed_tile_sprite, flag_sprite, mine_sprite,
+                        number_sprites, digits_sprite);
+        drawCounter(game_window, board.mines - flags, digits_sprite, rowCount);
+        drawTimer(game_window, totalSeconds / 60, totalSeconds % 60, rowCount, colCount, digits_texture, digits_sprite);
+        game_window.draw(face_sprites[gameWon ? 1 : (gameOver ? 2 : 0)]);
+        game_window.display();
+
+        // the 2D metrics don't apply, the entry is only tagged as a 3d win
+        if (gameWon && !scoreRecorded) {
+            scoreRecorded = recordWin(totalSeconds / 60, totalSeconds % 60, name, ", 3d");
+        }
+    }
+}
+
+// tiles an unbounded game opens per frame, the rest of a large opening
+// carries over to the next frames
+const int CHUNKED_REVEAL_PER_FRAME = 1 << 14;
+// chunks kept expanded in memory, the least recently drawn or played ones
+// beyond this shrink to their changes
+const size_t CHUNKED_LIVE_CHUNKS = 512;
+
+// opens the first blank tile of the chunk at the origin, so an unbounded
+// game starts on an opening instead of a guess; returns where it is
+sf::Vector2i openStartingArea(ChunkedBoard &board) {
+    for (int i = 0; i < CHUNK_CELLS; ++i) {
+        ChunkedBoard::Tile tile = board.getTileAt(i % CHUNK_SIZE, i / CHUNK_SIZE);
+        if (!tile.isMine() && tile.getSurroundingMines() == 0) {
+            board.reveal(i % CHUNK_SIZE, i / CHUNK_SIZE, CHUNKED_REVEAL_PER_FRAME);
+            return sf::Vector2i(i % CHUNK_SIZE, i / CHUNK_SIZE);
+        }
+    }
+    return sf::Vector2i(0, 0);
+}
+
+// unbounded game on a ChunkedBoard at the configured mine density: the
+// window is a cols x rows view that the arrow keys (or WASD) scroll. there
+// is nothing to win, the counter shows how many tiles have been opened
+void playChunkedGame(int colCount, int rowCount) {
+    sf::RenderWindow game_window(sf::VideoMode((colCount * 32), (rowCount * 32 + 100)), "Game Window", sf::Style::Close);
+
+    //read config for mines
+    string line;
+    ifstream config("config.cfg");
+    getline(config, line);
+    getline(config, line);
+    getline(config, line);
+    int mineCount = stoi(line);
+    int minesPerChunk = int(int64_t(mineCount) * CHUNK_CELLS / (int64_t(colCount) * rowCount));
+
+    ChunkedBoard board(minesPerChunk);
+    sf::Vector2i start = openStartingArea(board);
+    int left = start.x - colCount / 2;
+    int top = start.y - rowCount / 2;
+    bool gameOver = false;
+    sf::Clock clock;
+    sf::Time totalTime;
+
+    //sprites and textures
+    sf::Texture hidden_tile, revealed_texture, flag_texture, mine_texture, digits_texture;
+    sf::Texture face_happy_texture, face_lose_texture;
+    if (!hidden_tile.loadFromFile("images/tile_hidden.png") || !revealed_texture.loadFromFile("images/tile_revealed.png") ||
+        !flag_texture.loadFromFile("images/flag.png") || !mine_texture.loadFromFile("images/mine.png") ||
+        !digits_texture.loadFromFile("images/digits.png") || !face_happy_texture.loadFromFile("images/face_happy.png") ||
+        !face_lose_texture.loadFromFile("images/face_lose.png")) {
+        cout << "error" << endl;
+    }
+    sf::Sprite hidden_tile_sprite(hidden_tile);
+    sf::Sprite revealed_tile_sprite(revealed_texture);
+    sf::Sprite flag_sprite(flag_texture);
+    sf::Sprite mine_sprite(mine_texture);
+    sf::Sprite digits_sprite(digits_texture);
+    sf::Sprite face_sprites[2] = {sf::Sprite(face_happy_texture), sf::Sprite(face_lose_texture)};
+    for (int f = 0; f < 2; ++f) {
+        face_sprites[f].setPosition((colCount/2)*32 - 32, 32 * (rowCount + 0.5));
+    }
+    sf::Texture number_textures[8];
+    sf::Sprite number_sprites[8];
+    for (int n = 0; n < 8; ++n) {
+        if (!number_textures[n].loadFromFile("images/number_" + to_string(n + 1) + ".png")) {
+            cout << "error" << endl;
+        }
+        number_sprites[n].setTexture(number_textures[n]);
+    }
+
+    while (game_window.isOpen()) {
+        sf::Event event;
+        while (game_window.pollEvent(event)) {
+            switch (event.type) {
+                case sf::Event::Closed:
+                    game_window.close();
+                break;
+                case sf::Event::KeyPressed:
+                    if (event.key.code == sf::Keyboard::Left || event.key.code == sf::Keyboard::A) left -= 4;
+                    else if (event.key.code == sf::Keyboard::Right || event.key.code == sf::Keyboard::D) left += 4;
+                    else if (event.key.code == sf::Keyboard::Up || event.key.code == sf::Keyboard::W) top -= 4;
+                    else if (event.key.code == sf::Keyboard::Down || event.key.code == sf::Keyboard::S) top += 4;
+                break;
+                case sf::Event::MouseButtonPressed: {
+                    sf::Vector2i mousePos = sf::Mouse::getPosition(game_window);
+                    if (face_sprites[0].getGlobalBounds().contains(sf::Vector2f(mousePos))) {
+                        board = ChunkedBoard(minesPerChunk);
+                        start = openStartingArea(board);
+                        left = start.x - colCount / 2;
+                        top = start.y - rowCount / 2;
+                        gameOver = false;
+                        totalTime = sf::Time::Zero;
+                        break;
+                    }
+                    if (gameOver || mousePos.x < 0 || mousePos.x >= colCount * 32 || mousePos.y < 0 || mousePos.y >= rowCount * 32) {
+                        break;
+                    }
+                    int x = left + mousePos.x / 32;
+                    int y = top + mousePos.y / 32;
+                    ChunkedBoard::Tile tile = board.getTileAt(x, y);
+                    if (event.mouseButton.button == sf::Mouse::Left) {
+                        board.reveal(x, y, CHUNKED_REVEAL_PER_FRAME);
+                        gameOver = board.minesRevealed > 0;
+                    }
+                    else if (event.mouseButton.button == sf::Mouse::Right && tile.isHidden()) {
+                        tile.setFlagged(!tile.isFlagged());
+                    }
                 }
-                leaderboardFile.close();
-                scoreRecorded = true;
+                break;
             }
-            else {
-                cerr << "error" << endl;
+        }
+
+        // an opening on a sparse board can run on without end, so it spreads
+        // a slice per frame and only within a few screens of the view; tiles
+        // further out wait in the frontier until the view comes near
+        if (!gameOver && !board.frontier.empty()) {
+            int reach = 4 * max(colCount, rowCount);
+            int centerX = left + colCount / 2;
+            int centerY = top + rowCount / 2;
+            vector<sf::Vector2i> waiting;
+            size_t kept = 0;
+            for (size_t i = 0; i < board.frontier.size(); ++i) {
+                sf::Vector2i tile = board.frontier[i];
+                if (abs(tile.x - centerX) <= reach && abs(tile.y - centerY) <= reach) {
+                    board.frontier[kept++] = tile;
+                }
+                else {
+                    waiting.push_back(tile);
+                }
             }
+            board.frontier.resize(kept);
+            vector<sf::Vector2i> opened;
+            board.continueReveal(CHUNKED_REVEAL_PER_FRAME, opened);
+            board.frontier.insert(board.frontier.end(), waiting.begin(), waiting.end());
+        }
+
+        if (!gameOver) {
+            totalTime += clock.getElapsedTime();
+        }
+        clock.restart();
+        int totalSeconds = totalTime.asSeconds();
+
+        game_window.setTitle("Game Window - " + to_string(left) + ", " + to_string(top));
+        game_window.clear(sf::Color::White);
+        drawChunkedView(game_window, board, left, top, colCount, rowCount, hidden_tile_sprite, revealed_tile_sprite,
+                        flag_sprite, mine_sprite, number_sprites, gameOver);
+        drawCounter(game_window, board.revealedCount, digits_sprite, rowCount);
+        drawTimer(game_window, totalSeconds / 60, totalSeconds % 60, rowCount, colCount, digits_texture, digits_sprite);
+        game_window.draw(face_sprites[gameOver ? 1 : 0]);
+        game_window.display();
+
+        // drawing touched every chunk in view last, so those stay expanded
+        board.compact(CHUNKED_LIVE_CHUNKS);
+    }
+}
+
+void createGameWindow(int colCount, int rowCount, string name) {
+    // a config line reading "hex" or "torus" picks another topology, one
+    // reading "3d" and a layer count stacks that many layers into a cube
+    // (the configured mine count goes on every layer, keeping the density),
+    // "infinite" plays an unbounded board at the configured mine density
+    ifstream config("config.cfg");
+    string line;
+    bool hex = false;
+    bool torus = false;
+    bool infinite = false;
+    int layers = 0;
+    while (getline(config, line)) {
+        hex = hex || line == "hex";
+        torus = torus || line == "torus";
+        infinite = infinite || line == "infinite";
+        if (line.compare(0, 3, "3d ") == 0) {
+            layers = atoi(line.c_str() + 3);
         }
     }
+    if (layers > 0) {
+        playVolumeGame(colCount, rowCount, layers, name);
+    }
+    else if (infinite) {
+        playChunkedGame(colCount, rowCount);
+    }
+    else if (hex) {
+        playGame<BasicBoard<DYNAMIC_SIZE, DYNAMIC_SIZE, RowMajorLayout, HexTopology>>(colCount, rowCount, name);
+    }
+    else if (torus) {
+        playGame<BasicBoard<DYNAMIC_SIZE, DYNAMIC_SIZE, RowMajorLayout, TorusTopology>>(colCount, rowCount, name);
+    }
+    // the usual config sizes get a board specialized at compile time
+    else if (colCount == 30 && rowCount == 16) {
+        playGame<BasicBoard<30, 16>>(colCount, rowCount, name);
+    }
+    else if (colCount == 16 && rowCount == 16) {
+        playGame<BasicBoard<16, 16>>(colCount, rowCount, name);
+    }
+    else if (colCount == 9 && rowCount == 9) {
+        playGame<BasicBoard<9, 9>>(colCount, rowCount, name);
+    }
+    else {
+        playGame<Board>(colCount, rowCount, name);
+    }
 }
 
 void createWelcomeWindow(int colCount, int rowCount){
@@ -881,7 +4329,20 @@ void createWelcomeWindow(int colCount, int rowCount){
     }
 }
 
-int main() {
+// "--boards N": no window, N fresh boards of the configured size are
+// generated on the bitplane backend and printed as id and metrics, so good
+// boards can be picked out and replayed through config.cfg
+void printBoards(int colCount, int rowCount, int mineCount, int count) {
+    Board board(1, 1, 0);
+    for (int n = 0; n < count; ++n) {
+        BitBoard bits(rowCount, colCount, mineCount);
+        bits.assignSurroundingMines();
+        bits.copyTo(board);
+        cout << board.getId().toString() << " " << measureBoard(board).toString() << endl;
+    }
+}
+
+int main(int argc, char *argv[]) {
     // Read from the config for rows, cols, and mines #
     string line;
     ifstream config("config.cfg");
@@ -896,6 +4357,12 @@ int main() {
     getline(config, line);
     int rowCount = stoi(line);
 
+    if (argc == 3 && string(argv[1]) == "--boards") {
+        getline(config, line);
+        printBoards(colCount, rowCount, stoi(line), atoi(argv[2]));
+        return 0;
+    }
+
     createWelcomeWindow(colCount, rowCount);
 
     return 0;